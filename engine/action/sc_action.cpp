@@ -1355,7 +1355,21 @@ player_t* action_t::find_target_by_number( int number ) const
   return 0;
 }
 
+// action_t::record_crit_luck ===============================================
+
+// Crit roll outcome relative to the crit chance, accumulated on the owner of the action for
+// control_variates=1
+
+void action_t::record_crit_luck( double chance, bool crit ) const
+{
+  if ( ! sim -> control_variates )
+    return;
+
+  player -> get_owner_or_self() -> iteration_crit_luck += ( crit ? 1.0 : 0.0 ) - clamp( chance, 0.0, 1.0 );
+}
+
 // action_t::calculate_block_result =========================================
+
 // moved here now that we found out that spells can be blocked (Holy Shield)
 // block_chance() and crit_block_chance() govern whether any given attack can
 // be blocked or not (zero return if not)
@@ -1523,13 +1537,13 @@ void action_t::execute()
       // "On spell cast", only performed for foreground actions
       if ( ( pt2 = execute_state -> cast_proc_type2() ) != PROC2_INVALID )
       {
-        action_callback_t::trigger( player -> callbacks.procs[ pt ][ pt2 ], this, execute_state );
+        player -> callbacks.trigger( pt, pt2, this, execute_state );
       }
 
       // "On an execute result"
       if ( ( pt2 = execute_state -> execute_proc_type2() ) != PROC2_INVALID )
       {
-        action_callback_t::trigger( player -> callbacks.procs[ pt ][ pt2 ], this, execute_state );
+        player -> callbacks.trigger( pt, pt2, this, execute_state );
       }
     }
   }
@@ -1590,8 +1604,13 @@ void action_t::tick( dot_t* d )
   {
     d -> state -> result = RESULT_HIT;
 
-    if ( tick_may_crit && rng().roll( d -> state -> composite_crit_chance() ) )
-      d -> state -> result = RESULT_CRIT;
+    if ( tick_may_crit )
+    {
+      bool crit = rng().roll( d -> state -> composite_crit_chance() );
+      record_crit_luck( d -> state -> composite_crit_chance(), crit );
+      if ( crit )
+        d -> state -> result = RESULT_CRIT;
+    }
 
     d -> state -> result_amount = calculate_tick_amount( d -> state, d -> get_last_tick_factor() * d -> current_stack() );
 
@@ -2254,6 +2273,30 @@ bool action_t::init_finished()
   return ret;
 }
 
+// action_t::fold_expressions ===============================================
+
+int action_t::fold_expressions()
+{
+  int eliminated = 0;
+  auto fold = [ &eliminated ]( expr_t*& expr ) {
+    if ( ! expr )
+    {
+      return;
+    }
+
+    int nodes = expr -> node_count();
+    expr = expr -> fold();
+    eliminated += nodes - expr -> node_count();
+  };
+
+  fold( if_expr );
+  fold( target_if_expr );
+  fold( interrupt_if_expr );
+  fold( early_chain_if_expr );
+
+  return eliminated;
+}
+
 // action_t::reset ==========================================================
 
 void action_t::reset()
@@ -272,6 +272,15 @@ result_e attack_t::calculate_result( action_state_t* s ) const
         break;
       }
     }
+
+    for ( int i = 0; i < attack_table.num_results; ++i )
+    {
+      if ( attack_table.results[ i ] == RESULT_CRIT )
+      {
+        double low = i > 0 ? attack_table.chances[ i - 1 ] : 0.0;
+        record_crit_luck( attack_table.chances[ i ] - low, result == RESULT_CRIT );
+      }
+    }
   }
 
   assert( result != RESULT_NONE );
@@ -279,7 +288,9 @@ result_e attack_t::calculate_result( action_state_t* s ) const
   // if we have a special, make a second roll for hit/crit
   if ( result == RESULT_HIT && special && may_crit )
   {
-    if ( rng().roll( crit ) )
+    bool is_crit = rng().roll( crit );
+    record_crit_luck( crit, is_crit );
+    if ( is_crit )
       result = RESULT_CRIT;
   }
 
@@ -5,6 +5,163 @@
 
 #include "simulationcraft.hpp"
 
+// ==========================================================================
+// Batched Dot Ticks
+// ==========================================================================
+
+// Executes the ticks of the dots of a source actor that tick at the same time (batch_dot_ticks=1),
+// so that multi-dotting on many targets adds a single event to the timing wheel per tick time. The
+// tick events of the batched dots are not in the timing wheel themselves, they are chained through
+// their next pointers in the order they were scheduled in. The tick events keep working as before
+// for the dots: canceled ticks are skipped, and rescheduled ticks are batched again at their new
+// time.
+//
+// Batched ticks keep the ids they would have had as events of their own, and execute in id order
+// with the other events of the same time: when the next event in the timing wheel has the same time
+// and a lower id than the next tick, the remaining ticks are handed to a new batch event that takes
+// the id of that tick. Batching therefore does not change the order of execution or of random
+// number draws.
+struct dot_tick_batch_event_t : public event_t
+{
+  player_t* source;
+  dot_tick_event_t* first;
+  dot_tick_event_t* last;
+
+  dot_tick_batch_event_t( player_t* s, timespan_t delta_time ) :
+    event_t( *s, delta_time ), source( s ), first( nullptr ), last( nullptr )
+  { }
+
+  // Batch of the remaining ticks, inserted by the event manager at the place of its first tick
+  dot_tick_batch_event_t( player_t* s, dot_tick_event_t* f, dot_tick_event_t* l ) :
+    event_t( *s ), source( s ), first( f ), last( l )
+  {
+    scheduled = true;
+    time      = f -> time;
+    id        = f -> id;
+  }
+
+  const char* name() const override
+  { return "Dot-Tick-Batch"; }
+
+  void add( dot_tick_event_t* e )
+  {
+    if ( last )
+      last -> next = e;
+    else
+      first = e;
+    last = e;
+  }
+
+  void execute() override
+  {
+    // Ticks scheduled for the current time from now on go to a new batch
+    auto& batches = source -> dot_tick_batches;
+    auto it = range::find( batches, this );
+    if ( it != batches.end() )
+    {
+      *it = batches.back();
+      batches.pop_back();
+    }
+
+    event_manager_t& mgr = sim().event_mgr;
+    while ( first )
+    {
+      // Other events of the current time go first, if they were scheduled before the next tick
+      const event_t* pending = mgr.timing_wheel[ mgr.timing_slice ];
+      if ( pending && pending -> time == mgr.current_time && pending -> id < first -> id )
+      {
+        auto batch = new ( sim() ) dot_tick_batch_event_t( source, first, last );
+        mgr.insert_event( batch );
+        first = last = nullptr;
+        return;
+      }
+
+      dot_tick_event_t* e = first;
+      first = static_cast<dot_tick_event_t*>( e -> next );
+      e -> next = nullptr;
+
+#if ACTOR_EVENT_BOOKKEEPING
+      if ( sim().debug && e -> actor && ! e -> canceled )
+      {
+        e -> actor -> event_counter--;
+        assert( e -> actor -> event_counter >= 0 );
+      }
+#endif
+
+      if ( e -> canceled )
+      {
+        if ( sim().debug )
+          sim().out_debug.printf( "Canceled batched event: %s", e -> name() );
+      }
+      else if ( e -> reschedule_time > e -> time )
+      {
+        dot_tick_event_t::schedule_batched( e, e -> reschedule_time - mgr.current_time );
+        continue;
+      }
+      else
+      {
+        if ( sim().debug )
+          sim().out_debug.printf( "Executing batched event: %s", e -> name() );
+
+        e -> execute();
+      }
+
+      mgr.recycle_event( e );
+    }
+    last = nullptr;
+  }
+};
+
+// dot_tick_event_t::schedule_batched =======================================
+
+void dot_tick_event_t::schedule_batched( dot_tick_event_t* e, timespan_t time_to_tick )
+{
+  event_manager_t& mgr = e -> sim().event_mgr;
+
+  if ( time_to_tick < timespan_t::zero() )
+    time_to_tick = timespan_t::zero();
+
+  // Ticks beyond the timing wheel need the rescheduling of the event manager
+  if ( time_to_tick > mgr.wheel_time )
+  {
+    e -> scheduled = false;
+    e -> schedule( time_to_tick );
+    return;
+  }
+
+  player_t* source = e -> dot -> source;
+  timespan_t tick_time = mgr.current_time + time_to_tick;
+
+  dot_tick_batch_event_t* batch = nullptr;
+  for ( auto b : source -> dot_tick_batches )
+  {
+    if ( b -> time == tick_time )
+    {
+      batch = b;
+      break;
+    }
+  }
+
+  if ( ! batch )
+  {
+    batch = make_event<dot_tick_batch_event_t>( e -> sim(), source, time_to_tick );
+    source -> dot_tick_batches.push_back( batch );
+  }
+
+  e -> scheduled       = true;
+  e -> id              = ++mgr.global_event_id;
+  e -> time            = tick_time;
+  e -> reschedule_time = timespan_t::zero();
+  batch -> add( e );
+
+#if ACTOR_EVENT_BOOKKEEPING
+  if ( e -> sim().debug && e -> actor )
+  {
+    e -> actor -> event_counter++;
+  }
+#endif
+}
+
 // ==========================================================================
 // Dot
 // ==========================================================================
@@ -29,7 +186,8 @@ dot_t::dot_t( const std::string& n, player_t* t, player_t* s )
     max_stack( 0 ),
     miss_time( timespan_t::min() ),
     time_to_tick( timespan_t::zero() ),
-    name_str( n )
+    name_str( n ),
+    name_symbol( symbol::intern( n ) )
 {
 }
 
@@ -477,7 +635,7 @@ expr_t* dot_t::create_expression( action_t* action, const std::string& name_str,
       action->player->get_target_data( action->target );
       dot_t*& dot = specific_dot[ action->target ];
       if ( !dot )
-        dot = action->target->get_dot( static_dot->name(), action->player );
+        dot = action->target->get_dot( static_dot->name_symbol, action->player );
       return dot;
     }
   };
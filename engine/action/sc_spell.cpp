@@ -66,7 +66,9 @@ result_e spell_base_t::calculate_result( action_state_t* s ) const
 
     if ( may_crit )
     {
-      if ( rng().roll( std::max( s -> composite_crit_chance(), 0.0 ) ) )
+      bool crit = rng().roll( std::max( s -> composite_crit_chance(), 0.0 ) );
+      record_crit_luck( s -> composite_crit_chance(), crit );
+      if ( crit )
         result = RESULT_CRIT;
     }
   }
@@ -380,7 +382,7 @@ void heal_t::assess_damage( dmg_e heal_type,
     proc_types pt = s -> proc_type();
     proc_types2 pt2 = s -> impact_proc_type2();
     if ( pt != PROC1_INVALID && pt2 != PROC2_INVALID )
-      action_callback_t::trigger( player -> callbacks.procs[ pt ][ pt2 ], this, s );
+      player -> callbacks.trigger( pt, pt2, this, s );
   }
 
   if ( player -> record_healing() )
@@ -53,6 +53,11 @@ stats_t::stats_t( const std::string& n, player_t* p ) :
   {
     timeline_amount = std::unique_ptr<sc_timeline_t>( new sc_timeline_t() );
   }
+
+  if ( sim.stats_accumulator )
+  {
+    iteration_results = std::unique_ptr<result_accumulator_t>( new result_accumulator_t() );
+  }
 }
 
 // stats_t::add_child =======================================================
@@ -85,6 +90,33 @@ void stats_t::consume_resource( resource_e resource_type, double resource_amount
 void stats_t::reset()
 {
   last_execute = timespan_t::min();
+
+  // Results of iterations without data collection
+  fold_results();
+}
+
+// stats_t::fold_results ====================================================
+
+void stats_t::fold_results()
+{
+  if ( ! iteration_results )
+    return;
+
+  result_accumulator_t& r = *iteration_results;
+  for ( size_t i = 0; i < result_accumulator_t::N_RESULTS; ++i )
+  {
+    if ( r.pending[ i ] == 0 )
+      continue;
+
+    stats_results_t& sr = results( i );
+    sr.actual_amount.assign( r.actual_sum[ i ], sr.actual_amount.count() + r.pending[ i ] );
+    sr.actual_amount.add_range( r.actual_min[ i ], r.actual_max[ i ] );
+    sr.total_amount.assign( r.total_sum[ i ], sr.total_amount.count() + r.pending[ i ] );
+
+    r.pending[ i ] = 0;
+    r.actual_min[ i ] = std::numeric_limits<double>::max();
+    r.actual_max[ i ] = std::numeric_limits<double>::lowest();
+  }
 }
 
 full_result_e stats_t::translate_result( result_e result, block_result_e block_result )
@@ -120,6 +152,18 @@ full_result_e stats_t::translate_result( result_e result, block_result_e block_r
   return fulltype;
 }
 
+// stats_t::result_index ====================================================
+
+size_t stats_t::result_index( dmg_e dmg_type, result_e result, block_result_e block_result )
+{
+  if ( dmg_type == DMG_DIRECT || dmg_type == HEAL_DIRECT || dmg_type == ABSORB )
+  {
+    return translate_result( result, block_result );
+  }
+
+  return FULLTYPE_MAX + result;
+}
+
 // stats_t::add_result ======================================================
 
 void stats_t::add_result( double act_amount,
@@ -129,21 +173,50 @@ void stats_t::add_result( double act_amount,
                           block_result_e block_result,
                           player_t* /* target */ )
 {
-  stats_results_t* r = nullptr;
-  if ( dmg_type == DMG_DIRECT || dmg_type == HEAL_DIRECT || dmg_type == ABSORB )
+  if ( iteration_results )
   {
-    r = &( direct_results[ translate_result( result, block_result ) ] );
+    size_t idx = result_index( dmg_type, result, block_result );
+    result_accumulator_t& r = *iteration_results;
+
+    if ( r.pending[ idx ] == 0 )
+    {
+      r.actual_sum[ idx ] = results( idx ).actual_amount.sum();
+      r.total_sum[ idx ] = results( idx ).total_amount.sum();
+    }
+
+    r.count[ idx ] += 1;
+    r.actual_amount[ idx ] += act_amount;
+    r.total_amount[ idx ] += tot_amount;
+    r.pending[ idx ] += 1;
+    r.actual_sum[ idx ] += act_amount;
+    r.total_sum[ idx ] += tot_amount;
+    if ( act_amount < r.actual_min[ idx ] )
+    {
+      r.actual_min[ idx ] = act_amount;
+    }
+    if ( act_amount > r.actual_max[ idx ] )
+    {
+      r.actual_max[ idx ] = act_amount;
+    }
   }
   else
   {
-    r = &( tick_results[ result ] );
-  }
+    stats_results_t* r = nullptr;
+    if ( dmg_type == DMG_DIRECT || dmg_type == HEAL_DIRECT || dmg_type == ABSORB )
+    {
+      r = &( direct_results[ translate_result( result, block_result ) ] );
+    }
+    else
+    {
+      r = &( tick_results[ result ] );
+    }
 
-  r -> iteration_count += 1;
-  r -> iteration_actual_amount += act_amount;
-  r -> iteration_total_amount += tot_amount;
-  r -> actual_amount.add( act_amount );
-  r -> total_amount.add( tot_amount );
+    r -> iteration_count += 1;
+    r -> iteration_actual_amount += act_amount;
+    r -> iteration_total_amount += tot_amount;
+    r -> actual_amount.add( act_amount );
+    r -> total_amount.add( tot_amount );
+  }
 
   // Collect timeline data to stats-specific object if it exists, or to the player's global "damage
   // output" timeline (e.g., when report_details=0).
@@ -214,6 +287,11 @@ void stats_t::datacollection_begin()
 
   range::for_each( direct_results, []( stats_results_t& r ) { r.datacollection_begin(); } );
   range::for_each( tick_results, []( stats_results_t& r ) { r.datacollection_begin(); } );
+
+  if ( iteration_results )
+  {
+    iteration_results -> datacollection_begin();
+  }
 }
 
 // stats_t::datacollection_end ==============================================
@@ -225,6 +303,19 @@ void stats_t::datacollection_end()
   double idr = 0;
   double itr = 0;
 
+  if ( iteration_results )
+  {
+    fold_results();
+
+    const result_accumulator_t& r = *iteration_results;
+    for ( size_t i = 0; i < result_accumulator_t::N_RESULTS; ++i )
+    {
+      results( i ).iteration_count = r.count[ i ];
+      results( i ).iteration_actual_amount = r.actual_amount[ i ];
+      results( i ).iteration_total_amount = r.total_amount[ i ];
+    }
+  }
+
   range::for_each( direct_results, [ &idr, &iaa, &ita ]( stats_results_t& r ) {
     idr += r.iteration_count;
     iaa += r.iteration_actual_amount;
@@ -273,6 +364,24 @@ void stats_t::datacollection_end()
   }
 }
 
+// stats_t::result_accumulator_t ===========================================
+
+stats_t::result_accumulator_t::result_accumulator_t() :
+  count(), actual_amount(), total_amount(),
+  pending(), actual_sum(), total_sum(),
+  actual_min(), actual_max()
+{
+  actual_min.fill( std::numeric_limits<double>::max() );
+  actual_max.fill( std::numeric_limits<double>::lowest() );
+}
+
+void stats_t::result_accumulator_t::datacollection_begin()
+{
+  count.fill( 0 );
+  actual_amount.fill( 0.0 );
+  total_amount.fill( 0.0 );
+}
+
 // stats_t::analyze =========================================================
 
 void stats_t::analyze()
@@ -280,6 +389,8 @@ void stats_t::analyze()
   if ( analyzed ) return;
   analyzed = true;
 
+  fold_results();
+
   // When single_actor_batch=1 is used in conjunction with target_error, each actor has run varying
   // number of iterations to finish. The total number of iterations ran for each actor (when
   // single_actor_batch=1) is stored in the actor-collected data structure.
@@ -404,6 +515,20 @@ void stats_t::stats_results_t::merge( const stats_results_t& other )
   total_amount.merge( other.total_amount );
   overkill_pct.merge( other.overkill_pct );
 }
+
+// stats_results_t::serialize ===============================================
+
+void stats_t::stats_results_t::serialize( archive_t& ar )
+{
+  ar.merge( count );
+  ar.merge( fight_total_amount );
+  ar.merge( fight_actual_amount );
+  ar.merge( avg_actual_amount );
+  ar.merge( actual_amount );
+  ar.merge( total_amount );
+  ar.merge( overkill_pct );
+}
+
 // stats_results_t::datacollection_begin ====================================
 
 void stats_t::stats_results_t::datacollection_begin()
@@ -462,6 +587,36 @@ void stats_t::merge( const stats_t& other )
   }
 }
 
+// stats_t::serialize =======================================================
+
+void stats_t::serialize( archive_t& ar )
+{
+  fold_results();
+
+  resource_gain.serialize( ar );
+  ar.merge( num_direct_results );
+  ar.merge( num_tick_results );
+  ar.merge( num_executes );
+  ar.merge( num_ticks );
+  ar.merge( num_refreshes );
+  ar.merge( total_execute_time );
+  ar.merge( total_tick_time );
+
+  ar.merge( total_amount );
+  ar.merge( actual_amount );
+  ar.merge( portion_aps );
+  ar.merge( portion_apse );
+
+  auto results = []( archive_t& a, stats_results_t& r ) { r.serialize( a ); };
+  ar.sequence( tick_results, results );
+  ar.sequence( direct_results, results );
+
+  if ( timeline_amount )
+  {
+    ar.merge( *timeline_amount );
+  }
+}
+
 bool stats_t::has_direct_amount_results() const
 {
   return (
@@ -167,6 +167,7 @@ buff_t::buff_t( const buff_creation::buff_creator_basics_t& params ) :
   player( params._player.target ),
   item( params.item ),
   name_str( params._name ),
+  name_symbol( symbol::intern( params._name ) ),
   s_data( params.s_data ),
   source( params._player.source ),
   expiration(),
@@ -224,11 +225,14 @@ buff_t::buff_t( const buff_creation::buff_creator_basics_t& params ) :
   if ( source ) // Player Buffs
   {
     player -> buff_list.push_back( this );
+    player -> buff_index.insert( name_symbol, this, source );
+    player -> buff_index.insert( name_symbol, this ); // Lookup regardless of source
     cooldown = source -> get_cooldown( "buff_" + name_str );
   }
   else // Sim Buffs
   {
     sim -> buff_list.push_back( this );
+    sim -> buff_index.insert( name_symbol, this );
     cooldown = sim -> get_cooldown( "buff_" + name_str );
   }
 
@@ -1571,6 +1575,27 @@ void buff_t::merge( const buff_t& other )
     stack_uptime[ i ].merge ( other.stack_uptime[ i ] );
 }
 
+// buff_t::serialize ========================================================
+
+void buff_t::serialize( archive_t& ar )
+{
+  ar.merge( start_intervals );
+  ar.merge( trigger_intervals );
+
+  ar.merge( uptime_pct );
+  ar.merge( benefit_pct );
+  ar.merge( trigger_pct );
+  ar.merge( avg_start );
+  ar.merge( avg_refresh );
+  ar.merge( avg_expire );
+  ar.merge( avg_overflow_count );
+  ar.merge( avg_overflow_total );
+  if ( sim -> buff_uptime_timeline )
+    ar.merge( uptime_array );
+
+  ar.sequence( stack_uptime, []( archive_t& a, buff_uptime_t& uptime ) { uptime.serialize( a ); } );
+}
+
 // buff_t::analyze ==========================================================
 
 void buff_t::analyze()
@@ -1692,18 +1717,20 @@ expr_t* buff_t::create_expression(  std::string buff_name,
   struct buff_expr_t : public expr_t
   {
     std::string buff_name;
+    symbol_t buff_symbol;
     action_t* action;
     buff_t* static_buff;
     target_specific_t<buff_t> specific_buff;
 
     buff_expr_t( const std::string& n, const std::string& bn, action_t* a, buff_t* b ) :
-      expr_t( n ), buff_name( bn ), action( a ), static_buff( b ), specific_buff( false ) {}
+      expr_t( n ), buff_name( bn ), buff_symbol( symbol::intern( bn ) ), action( a ), static_buff( b ),
+      specific_buff( false ) {}
 
     virtual buff_t* create() const
     {
       action -> player -> get_target_data( action -> target );
-      auto buff = buff_t::find( action -> target, buff_name, action -> player );
-      if ( ! buff ) buff = buff_t::find( action -> target, buff_name, action -> target ); // Raid debuffs
+      auto buff = buff_t::find( action -> target, buff_symbol, action -> player );
+      if ( ! buff ) buff = buff_t::find( action -> target, buff_symbol, action -> target ); // Raid debuffs
       if ( ! buff )
       {
         action -> sim -> errorf( "Reference to unknown buff/debuff %s by player %s", buff_name.c_str(), action -> player -> name() );
@@ -796,8 +796,8 @@ public:
   // Pets and Guardians
   struct pets_t
   {
-    std::array< pets::death_knight_pet_t*, 8 > army_ghoul;
-    std::array< pets::death_knight_pet_t*, 8 > apocalypse_ghoul;
+    pet_spawner_t<pets::death_knight_pet_t>* army_ghoul;
+    pet_spawner_t<pets::death_knight_pet_t>* apocalypse_ghoul;
     std::array< pets::dancing_rune_weapon_pet_t*, 2 > dancing_rune_weapon;
     pets::dt_pet_t* ghoul_pet; // Covers both Ghoul and Sludge Belcher
     pets::death_knight_pet_t* gargoyle;
@@ -890,8 +890,6 @@ public:
     legendary( legendary_t() ),
     _runes( this )
   {
-    range::fill( pets.army_ghoul, nullptr );
-    range::fill( pets.apocalypse_ghoul, nullptr );
     range::fill( pets.dancing_rune_weapon, nullptr );
 
     cooldown.antimagic_shell = get_cooldown( "antimagic_shell" );
@@ -990,6 +988,7 @@ public:
   void      invalidate_cache( cache_e ) override;
   double    resource_loss( resource_e resource_type, double amount, gain_t* g = nullptr, action_t* a = nullptr ) override;
   void      merge( player_t& other ) override;
+  void      serialize( archive_t& ar ) override;
   void      analyze( sim_t& sim ) override;
   std::string default_potion() const override;
   std::string default_flask() const override;
@@ -3765,7 +3764,7 @@ struct apocalypse_t : public death_knight_melee_attack_t
           duration = timespan_t::from_seconds( 1 );
         }
 
-        p() -> pets.apocalypse_ghoul[ i ] -> summon( duration );
+        p() -> pets.apocalypse_ghoul -> spawn( duration );
         p() -> buffs.t20_2pc_unholy -> trigger();
       }
     }
@@ -3814,7 +3813,7 @@ struct army_of_the_dead_t : public death_knight_spell_t
       // TODO: DBC
       for ( int i = 0; i < 8; i++ )
       {
-        p() -> pets.army_ghoul[ i ] -> summon( timespan_t::from_seconds( 34 ) );
+        p() -> pets.army_ghoul -> spawn( timespan_t::from_seconds( 34 ) );
         p() -> buffs.t20_2pc_unholy -> trigger();
       }
 
@@ -3838,7 +3837,7 @@ struct army_of_the_dead_t : public death_knight_spell_t
       // TODO: DBC
       for ( int i = 0; i < 8; i++ )
       {
-        p() -> pets.army_ghoul[ i ] -> summon( timespan_t::from_seconds( 40 ) );
+        p() -> pets.army_ghoul -> spawn( timespan_t::from_seconds( 40 ) );
         p() -> buffs.t20_2pc_unholy -> trigger();
       }
     }
@@ -3846,7 +3845,7 @@ struct army_of_the_dead_t : public death_knight_spell_t
 
   virtual bool ready() override
   {
-    if ( p() -> pets.army_ghoul[ 0 ] && ! p() -> pets.army_ghoul[ 0 ] -> is_sleeping() )
+    if ( p() -> pets.army_ghoul && p() -> pets.army_ghoul -> n_active_pets() > 0 )
       return false;
 
     return death_knight_spell_t::ready();
@@ -4463,20 +4462,17 @@ struct dark_transformation_t : public death_knight_spell_t
       p() -> pets.gargoyle -> taktheritrix -> trigger();
     }
 
-    for ( size_t i = 0; i < p() -> pets.army_ghoul.size(); i++ )
+    for ( auto spawner : { p() -> pets.army_ghoul, p() -> pets.apocalypse_ghoul } )
     {
-      if ( p() -> pets.army_ghoul[ i ] && p() -> pets.army_ghoul[ i ] -> taktheritrix )
-      {
-        p() -> pets.army_ghoul[ i ] -> taktheritrix -> trigger();
-      }
-    }
+      if ( ! spawner )
+        continue;
 
-    for ( size_t i = 0; i < p() -> pets.apocalypse_ghoul.size(); i++ )
-    {
-      if ( p() -> pets.apocalypse_ghoul[ i ] &&
-        p() -> pets.apocalypse_ghoul[ i ] -> taktheritrix )
+      for ( auto ghoul : *spawner )
       {
-        p() -> pets.apocalypse_ghoul[ i ] -> taktheritrix -> trigger();
+        if ( ghoul -> taktheritrix )
+        {
+          ghoul -> taktheritrix -> trigger();
+        }
       }
     }
   }
@@ -7226,6 +7222,14 @@ void death_knight_t::merge( player_t& other )
   _runes.cumulative_waste.merge( dk._runes.cumulative_waste );
 }
 
+void death_knight_t::serialize( archive_t& ar )
+{
+  player_t::serialize( ar );
+
+  ar.merge( _runes.rune_waste );
+  ar.merge( _runes.cumulative_waste );
+}
+
 void death_knight_t::analyze( sim_t& s )
 {
   player_t::analyze( s );
@@ -7752,18 +7756,14 @@ void death_knight_t::create_pets()
 
     if ( find_action( "army_of_the_dead" ) )
     {
-      for ( int i = 0; i < 8; i++ )
-      {
-        pets.army_ghoul[ i ] = new pets::army_pet_t( this, "army_ghoul" );
-      }
+      pets.army_ghoul = new pet_spawner_t<pets::death_knight_pet_t>( this, "army_ghoul",
+        []( player_t* p ) { return new pets::army_pet_t( debug_cast<death_knight_t*>( p ), "army_ghoul" ); }, 8 );
     }
 
     if ( artifact.apocalypse.rank() && find_action( "apocalypse" ) )
     {
-      for ( auto i = 0; i < 8; i++ )
-      {
-        pets.apocalypse_ghoul[ i ] = new pets::army_pet_t( this, "apocalypse_ghoul" );
-      }
+      pets.apocalypse_ghoul = new pet_spawner_t<pets::death_knight_pet_t>( this, "apocalypse_ghoul",
+        []( player_t* p ) { return new pets::army_pet_t( debug_cast<death_knight_t*>( p ), "apocalypse_ghoul" ); }, 8 );
     }
   }
 
@@ -9705,14 +9705,15 @@ struct taktheritrixs_shoulderpads_t : public scoped_actor_callback_t<death_knigh
     create_buff( p -> pets.gargoyle );
     create_buff( p -> pets.dark_arbiter );
 
-    for ( size_t i = 0; i < p -> pets.army_ghoul.size(); i++ )
+    for ( auto spawner : { p -> pets.army_ghoul, p -> pets.apocalypse_ghoul } )
     {
-      create_buff( p -> pets.army_ghoul[ i ] );
-    }
+      if ( ! spawner )
+        continue;
 
-    for ( size_t i = 0; i < p -> pets.apocalypse_ghoul.size(); i++ )
-    {
-      create_buff( p -> pets.apocalypse_ghoul[ i ] );
+      for ( auto ghoul : *spawner )
+      {
+        create_buff( ghoul );
+      }
     }
   }
 
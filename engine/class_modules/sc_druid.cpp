@@ -237,6 +237,15 @@ struct snapshot_counter_t
     tick_down += other.tick_down;
     wasted_buffs += other.wasted_buffs;
   }
+
+  void serialize( archive_t& ar )
+  {
+    ar.add( exe_up );
+    ar.add( exe_down );
+    ar.add( tick_up );
+    ar.add( tick_down );
+    ar.add( wasted_buffs );
+  }
 };
 
 struct druid_t : public player_t
@@ -843,6 +852,7 @@ public:
   virtual void      arise() override;
   virtual void      reset() override;
   virtual void      merge( player_t& other ) override;
+  virtual void      serialize( archive_t& ar ) override;
   virtual timespan_t available() const override;
   virtual double    composite_armor_multiplier() const override;
   virtual double    composite_attack_power_multiplier() const override;
@@ -8509,6 +8519,15 @@ void druid_t::merge( player_t& other )
     counters[ i ] -> merge( *od.counters[ i ] );
 }
 
+// druid_t::serialize =======================================================
+
+void druid_t::serialize( archive_t& ar )
+{
+  player_t::serialize( ar );
+
+  ar.sequence( counters, []( archive_t& a, snapshot_counter_t* c ) { c -> serialize( a ); } );
+}
+
 // druid_t::mana_regen_per_second ===========================================
 
 double druid_t::mana_regen_per_second() const
@@ -4,6 +4,7 @@
 // ==========================================================================
 
 #include "simulationcraft.hpp"
+#include "sim/sc_health_calibration.hpp"
 
 // ==========================================================================
 // Enemy
@@ -31,6 +32,8 @@ struct enemy_t : public player_t
   double fixed_health, initial_health;
   double fixed_health_percentage, initial_health_percentage;
   double health_recalculation_dampening_exponent;
+  // Initial health starts from the calibrated health of the simulation
+  bool health_calibrated;
   timespan_t waiting_time;
 
   int current_target;
@@ -44,6 +47,7 @@ struct enemy_t : public player_t
     fixed_health( 0 ), initial_health( 0 ),
     fixed_health_percentage( 0 ), initial_health_percentage( 100.0 ),
     health_recalculation_dampening_exponent( 1.0 ),
+    health_calibrated( false ),
     waiting_time( timespan_t::from_seconds( 1.0 ) ),
     current_target( 0 ),
     apply_damage_taken_debuff( 0 )
@@ -76,7 +80,9 @@ struct enemy_t : public player_t
   virtual double health_percentage() const override;
   virtual void combat_begin() override;
   virtual void combat_end() override;
+  virtual void serialize( archive_t& ar ) override;
   virtual void recalculate_health();
+  void init_initial_health();
   virtual void demise() override;
   virtual expr_t* create_expression( action_t* action, const std::string& type ) override;
   virtual timespan_t available() const override { return waiting_time; }
@@ -89,7 +95,7 @@ struct enemy_t : public player_t
     }
     else
     {
-      initial_health = fixed_health;
+      init_initial_health();
     }
   }
 
@@ -1187,7 +1193,7 @@ void enemy_t::init_base_stats()
   }
   else
   {
-    initial_health = fixed_health;
+    init_initial_health();
   }
 
   if ( this == sim -> target )
@@ -1548,6 +1554,20 @@ double enemy_t::health_percentage() const
   return resources.pct( RESOURCE_HEALTH ) * 100 ;
 }
 
+// enemy_t::init_initial_health =============================================
+
+void enemy_t::init_initial_health()
+{
+  initial_health = fixed_health;
+  health_calibrated = false;
+
+  if ( fixed_health <= 0 )
+  {
+    initial_health = sim -> health_calibration -> enemy_health( name_str );
+    health_calibrated = initial_health > 0;
+  }
+}
+
 // enemy_t::recalculate_health ==============================================
 
 void enemy_t::recalculate_health()
@@ -1561,7 +1581,9 @@ void enemy_t::recalculate_health()
   else
   {
     timespan_t delta_time = sim -> current_time() - sim -> expected_iteration_time;
-    delta_time /= std::pow( ( sim -> current_iteration + 1 ), health_recalculation_dampening_exponent ); // dampening factor, by default 1/n
+    // dampening factor, by default 1/n, including the iterations of the calibrated health
+    int n = sim -> current_iteration + 1 + ( health_calibrated ? sim -> health_calibration -> iterations : 0 );
+    delta_time /= std::pow( n, health_recalculation_dampening_exponent );
     double factor = 1.0 - ( delta_time / sim -> expected_iteration_time );
 
     if ( factor > 1.5 ) factor = 1.5;
@@ -1576,6 +1598,16 @@ void enemy_t::recalculate_health()
   if ( sim -> debug ) sim -> out_debug.printf( "Target %s initial health calculated to be %.0f. Damage was %.0f", name(), initial_health, iteration_dmg_taken );
 }
 
+// enemy_t::serialize =======================================================
+
+void enemy_t::serialize( archive_t& ar )
+{
+  player_t::serialize( ar );
+
+  // Health estimate carried over from the previous iterations
+  ar.state( initial_health );
+}
+
 bool enemy_t::taunt( player_t* source )
 {
   current_target = (int) source -> actor_index;
@@ -1676,14 +1708,20 @@ void enemy_t::combat_end()
   player_t::combat_end();
 
   if ( ! sim -> overrides.target_health.size() )
+  {
     recalculate_health();
+
+    if ( fixed_health <= 0 )
+      health_calibration_t::add_estimate( *sim, name_str, initial_health );
+  }
 }
 
 void enemy_t::demise()
 {
   if ( this == sim -> target )
   {
-    if ( sim -> current_iteration != 0 || sim -> overrides.target_health.size() > 0 || fixed_health > 0 )
+    if ( sim -> current_iteration != 0 || sim -> overrides.target_health.size() > 0 || fixed_health > 0 ||
+         health_calibrated )
       // For the main target, end simulation on death.
       sim -> cancel_iteration();
   }
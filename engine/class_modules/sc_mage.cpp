@@ -239,6 +239,12 @@ struct cooldown_waste_data_t : private noncopyable
     cumulative.merge( other.cumulative );
   }
 
+  void serialize( archive_t& ar )
+  {
+    ar.merge( normal );
+    ar.merge( cumulative );
+  }
+
   void analyze()
   {
     normal.analyze();
@@ -304,6 +310,11 @@ struct proc_source_t : private noncopyable
     }
   }
 
+  void serialize( archive_t& ar )
+  {
+    ar.sequence( procs, []( archive_t& a, proc_t* p ) { p -> serialize( a ); } );
+  }
+
   void datacollection_begin()
   {
     range::for_each( procs, std::mem_fn( &proc_t::datacollection_begin ) );
@@ -764,6 +775,7 @@ public:
   virtual std::string create_profile( save_e ) override;
   virtual void        copy_from( player_t* ) override;
   virtual void        merge( player_t& ) override;
+  virtual void        serialize( archive_t& ) override;
   virtual void        analyze( sim_t& ) override;
   virtual void        datacollection_begin() override;
   virtual void        datacollection_end() override;
@@ -7159,6 +7171,37 @@ void mage_t::merge( player_t& other )
   }
 }
 
+// mage_t::serialize =====================================================
+
+void mage_t::serialize( archive_t& ar )
+{
+  player_t::serialize( ar );
+
+  ar.sequence( cooldown_waste_data_list, []( archive_t& a, cooldown_waste_data_t* cd ) { cd -> serialize( a ); } );
+  ar.sequence( proc_source_list, []( archive_t& a, proc_source_t* ps ) { ps -> serialize( a ); } );
+
+  switch ( specialization() )
+  {
+    case MAGE_ARCANE:
+      ar.merge( *sample_data.burn_duration_history );
+      ar.merge( *sample_data.burn_initial_mana );
+      break;
+
+    case MAGE_FIRE:
+      break;
+
+    case MAGE_FROST:
+      if ( talents.thermal_void -> ok() )
+      {
+        ar.merge( *sample_data.icy_veins_duration );
+      }
+      break;
+
+    default:
+      break;
+  }
+}
+
 // mage_t::analyze =======================================================
 
 void mage_t::analyze( sim_t& s )
@@ -204,6 +204,12 @@ struct counter_t
     value += other.value;
     interval += other.interval;
   }
+
+  void serialize( archive_t& ar )
+  {
+    ar.add( value );
+    ar.add( interval );
+  }
 };
 
 struct shaman_t : public player_t
@@ -706,6 +712,7 @@ public:
   void      arise() override;
   void      reset() override;
   void      merge( player_t& other ) override;
+  void      serialize( archive_t& ar ) override;
   void      copy_from( player_t* ) override;
 
   void     datacollection_begin() override;
@@ -8418,6 +8425,19 @@ void shaman_t::merge( player_t& other )
   }
 }
 
+// shaman_t::serialize =====================================================
+
+void shaman_t::serialize( archive_t& ar )
+{
+  player_t::serialize( ar );
+
+  ar.sequence( counters, []( archive_t& a, counter_t* c ) { c -> serialize( a ); } );
+
+  auto waste = []( archive_t& a, data_t* d ) { a.merge( d -> second ); };
+  ar.sequence( cd_waste_exec, waste );
+  ar.sequence( cd_waste_cumulative, waste );
+}
+
 // shaman_t::datacollection_begin ===========================================
 
 void shaman_t::datacollection_begin()
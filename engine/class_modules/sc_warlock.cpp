@@ -125,7 +125,7 @@ public:
     static const int DOOMGUARD_LIMIT = 1;
     static const int LORD_OF_FLAMES_INFERNAL_LIMIT = 3;
     static const int DARKGLARE_LIMIT = 1;
-    std::array<pets::wild_imp_pet_t*, WILD_IMP_LIMIT> wild_imps;
+    pet_spawner_t<pets::wild_imp_pet_t>* wild_imps;
     std::array<pets::t18_illidari_satyr_t*, T18_PET_LIMIT> t18_illidari_satyr;
     std::array<pets::t18_prince_malchezaar_t*, T18_PET_LIMIT> t18_prince_malchezaar;
     std::array<pets::t18_vicious_hellhound_t*, T18_PET_LIMIT> t18_vicious_hellhound;
@@ -133,7 +133,7 @@ public:
     std::array<pets::flame_rift::flame_rift_t*, DIMENSIONAL_RIFT_LIMIT> flame_rift;
     std::array<pets::chaos_tear_t*, DIMENSIONAL_RIFT_LIMIT> chaos_tear;
     std::array<pets::chaos_portal::chaos_portal_t*, DIMENSIONAL_RIFT_LIMIT> chaos_portal;
-    std::array<pets::dreadstalker_t*, DREADSTALKER_LIMIT> dreadstalkers;
+    pet_spawner_t<pets::dreadstalker_t>* dreadstalkers;
     std::array<pets::infernal_t*, INFERNAL_LIMIT> infernal;
     std::array<pets::doomguard_t*, DOOMGUARD_LIMIT> doomguard;
     std::array<pets::lord_of_flames_infernal_t*, LORD_OF_FLAMES_INFERNAL_LIMIT> lord_of_flames_infernal;
@@ -2761,24 +2761,16 @@ public:
 
   static void trigger_wild_imp( warlock_t* p, bool doge = false, int duration = 12001 )
   {
-    for ( size_t i = 0; i < p -> warlock_pet_list.wild_imps.size(); i++ )
+    // An exhausted pool summons its longest active imp again
+    pets::wild_imp_pet_t* imp = p -> warlock_pet_list.wild_imps -> acquire();
+    imp -> trigger(duration, doge);
+    p -> procs.wild_imp -> occur();
+    if( p -> legendary.wilfreds_sigil_of_superior_summoning_flag && !p -> talents.grimoire_of_supremacy -> ok() )
     {
-      if ( p -> warlock_pet_list.wild_imps[i] -> is_sleeping() )
-      {
-
-        p -> warlock_pet_list.wild_imps[i] -> trigger(duration, doge);
-        p -> procs.wild_imp -> occur();
-        if( p -> legendary.wilfreds_sigil_of_superior_summoning_flag && !p -> talents.grimoire_of_supremacy -> ok() )
-        {
-            p -> cooldowns.doomguard -> adjust( p -> legendary.wilfreds_sigil_of_superior_summoning );
-            p -> cooldowns.infernal -> adjust( p -> legendary.wilfreds_sigil_of_superior_summoning );
-            p -> procs.wilfreds_imp -> occur();
-        }
-        return;
-      }
+        p -> cooldowns.doomguard -> adjust( p -> legendary.wilfreds_sigil_of_superior_summoning );
+        p -> cooldowns.infernal -> adjust( p -> legendary.wilfreds_sigil_of_superior_summoning );
+        p -> procs.wilfreds_imp -> occur();
     }
-    //p -> sim -> errorf( "Playerd %s ran out of wild imps.\n", p -> name() );
-    //assert( false ); // Will only get here if there are no available imps
   }
 
 };
@@ -3682,14 +3674,14 @@ struct demonic_empowerment_t: public warlock_spell_t
 
     if ( p()->sets->has_set_bonus( WARLOCK_DEMONOLOGY, T21, B4 ) )
     {
-      for ( size_t i = 0; i < p()->warlock_pet_list.dreadstalkers.size(); i++ )
+      for ( auto dreadstalker : *p()->warlock_pet_list.dreadstalkers )
       {
-        if ( !p()->warlock_pet_list.dreadstalkers[i]->is_sleeping() )
+        if ( !dreadstalker->is_sleeping() )
         {
-          if ( !p()->warlock_pet_list.dreadstalkers[i]->t21_4pc_reset )
+          if ( !dreadstalker->t21_4pc_reset )
           {
-            p()->warlock_pet_list.dreadstalkers[i]->dreadbite_executes++;
-            p()->warlock_pet_list.dreadstalkers[i]->t21_4pc_reset = true;
+            dreadstalker->dreadbite_executes++;
+            dreadstalker->t21_4pc_reset = true;
           }
         }
       }
@@ -3763,16 +3755,9 @@ struct hand_of_guldan_t: public warlock_spell_t
           p -> procs.fragment_wild_imp -> occur();
         }
       }
-      for ( pets::wild_imp_pet_t* wild_imp : p -> warlock_pet_list.wild_imps )
+      for ( ; count > 0; count-- )
       {
-        if ( wild_imp -> is_sleeping() )
-        {
-          count--;
-
-          trigger_wild_imp( p );
-        }
-        if ( count == 0 )
-          return;
+        trigger_wild_imp( p );
       }
     }
   };
@@ -5151,28 +5136,23 @@ struct call_dreadstalkers_t : public warlock_spell_t
   {
     warlock_spell_t::execute();
 
-    int j = 0;
-
-    for ( size_t i = 0; i < p() -> warlock_pet_list.dreadstalkers.size(); i++ )
+    for ( int j = 0; j < dreadstalker_count; j++ )
     {
-      if ( p() -> warlock_pet_list.dreadstalkers[i] -> is_sleeping() )
+      pets::dreadstalker_t* dreadstalker = p() -> warlock_pet_list.dreadstalkers -> spawn( dreadstalker_duration );
+
+      p()->procs.dreadstalker_debug->occur();
+
+      if ( p()->sets->has_set_bonus( WARLOCK_DEMONOLOGY, T21, B2 ))
+      { 
+	      dreadstalker -> buffs.rage_of_guldan -> set_duration( dreadstalker_duration );
+	      dreadstalker -> buffs.rage_of_guldan -> set_default_value( p() -> buffs.rage_of_guldan -> stack_value());
+	      dreadstalker -> buffs.rage_of_guldan -> trigger();
+      }
+      if(p()->legendary.wilfreds_sigil_of_superior_summoning_flag && !p()->talents.grimoire_of_supremacy->ok())
       {
-        p() -> warlock_pet_list.dreadstalkers[i] -> summon( dreadstalker_duration );
-        p()->procs.dreadstalker_debug->occur();
-
-        if ( p()->sets->has_set_bonus( WARLOCK_DEMONOLOGY, T21, B2 ))
-        { 
-		      p() -> warlock_pet_list.dreadstalkers[i] -> buffs.rage_of_guldan -> set_duration( dreadstalker_duration );
-		      p() -> warlock_pet_list.dreadstalkers[i] -> buffs.rage_of_guldan -> set_default_value( p() -> buffs.rage_of_guldan -> stack_value());
-		      p() -> warlock_pet_list.dreadstalkers[i] -> buffs.rage_of_guldan -> trigger();
-        }
-        if(p()->legendary.wilfreds_sigil_of_superior_summoning_flag && !p()->talents.grimoire_of_supremacy->ok())
-        {
-            p()->cooldowns.doomguard->adjust(p()->legendary.wilfreds_sigil_of_superior_summoning);
-            p()->cooldowns.infernal->adjust(p()->legendary.wilfreds_sigil_of_superior_summoning);
-            p()->procs.wilfreds_dog->occur();
-        }
-        if ( ++j == dreadstalker_count ) break;
+          p()->cooldowns.doomguard->adjust(p()->legendary.wilfreds_sigil_of_superior_summoning);
+          p()->cooldowns.infernal->adjust(p()->legendary.wilfreds_sigil_of_superior_summoning);
+          p()->procs.wilfreds_dog->occur();
       }
     }
 
@@ -5342,11 +5322,7 @@ struct implosion_t : public warlock_spell_t
 
       if(r)
       {
-          for ( auto imp : p() -> warlock_pet_list.wild_imps )
-          {
-            if ( !imp -> is_sleeping() )
-              return true;
-          }
+          return p() -> warlock_pet_list.wild_imps -> n_active_pets() > 0;
       }
       return false;
     }
@@ -5354,7 +5330,7 @@ struct implosion_t : public warlock_spell_t
     virtual void execute() override
     {
       warlock_spell_t::execute();
-      for( auto imp : p() -> warlock_pet_list.wild_imps )
+      for( auto imp : *p() -> warlock_pet_list.wild_imps )
       {
         if( !imp -> is_sleeping() )
         {
@@ -6628,17 +6604,10 @@ void warlock_t::create_pets()
 
   if ( specialization() == WARLOCK_DEMONOLOGY )
   {
-    for ( size_t i = 0; i < warlock_pet_list.wild_imps.size(); i++ )
-    {
-      warlock_pet_list.wild_imps[ i ] = new pets::wild_imp_pet_t( sim, this );
-      if ( i > 0 )
-        warlock_pet_list.wild_imps[ i ] -> quiet = 1;
-      //warlock_pet_list.wild_imps [ i ].ascendance = new thalkiels_ascendance_pet_spell_t( *warlock_pet_list.wild_imps [ i ] );
-    }
-    for ( size_t i = 0; i < warlock_pet_list.dreadstalkers.size(); i++ )
-    {
-      warlock_pet_list.dreadstalkers[ i ] = new pets::dreadstalker_t( sim, this );
-    }
+    warlock_pet_list.wild_imps = new pet_spawner_t<pets::wild_imp_pet_t>( this, "wild_imp",
+      [ this ]( player_t* ) { return new pets::wild_imp_pet_t( sim, this ); }, pets_t::WILD_IMP_LIMIT );
+    warlock_pet_list.dreadstalkers = new pet_spawner_t<pets::dreadstalker_t>( this, "dreadstalker",
+      [ this ]( player_t* ) { return new pets::dreadstalker_t( sim, this ); }, pets_t::DREADSTALKER_LIMIT );
     for ( size_t i = 0; i < warlock_pet_list.darkglare.size(); i++ )
     {
       warlock_pet_list.darkglare[i] = new pets::darkglare_t( sim, this );
@@ -7656,13 +7625,7 @@ expr_t* warlock_t::create_expression( action_t* a, const std::string& name_str )
           expr_t( "wild_imp_count" ), player( p ) { }
         virtual double evaluate() override
         {
-            double t = 0;
-            for(auto& pet : player.warlock_pet_list.wild_imps)
-            {
-                if(!pet->is_sleeping())
-                    t++;
-            }
-            return t;
+            return static_cast<double>( player.warlock_pet_list.wild_imps -> n_active_pets() );
         }
 
     };
@@ -7702,13 +7665,7 @@ expr_t* warlock_t::create_expression( action_t* a, const std::string& name_str )
             expr_t( "dreadstalker_count" ), player( p ) { }
           virtual double evaluate() override
           {
-              double t = 0;
-              for(auto& pet : player.warlock_pet_list.dreadstalkers)
-              {
-                  if(!pet->is_sleeping())
-                      t++;
-              }
-              return t;
+              return static_cast<double>( player.warlock_pet_list.dreadstalkers -> n_active_pets() );
           }
 
       };
@@ -7828,7 +7785,7 @@ expr_t* warlock_t::create_expression( action_t* a, const std::string& name_str )
           virtual double evaluate() override
           {
               double t = 0;
-              for(auto& pet : player.warlock_pet_list.wild_imps)
+              for(auto pet : *player.warlock_pet_list.wild_imps)
               {
                   if(!pet->is_sleeping() & !pet->buffs.demonic_empowerment->up())
                       t++;
@@ -7874,7 +7831,7 @@ expr_t* warlock_t::create_expression( action_t* a, const std::string& name_str )
           virtual double evaluate() override
           {
               double t = 0;
-              for(auto& pet : player.warlock_pet_list.dreadstalkers)
+              for(auto pet : *player.warlock_pet_list.dreadstalkers)
               {
                   if(!pet->is_sleeping() & !pet->buffs.demonic_empowerment->up())
                       t++;
@@ -7970,7 +7927,7 @@ expr_t* warlock_t::create_expression( action_t* a, const std::string& name_str )
           virtual double evaluate() override
           {
               double t = 150000;
-              for(auto& pet : player.warlock_pet_list.wild_imps)
+              for(auto pet : *player.warlock_pet_list.wild_imps)
               {
                   if(!pet->is_sleeping() & !pet->buffs.demonic_empowerment->up())
                   {
@@ -8022,7 +7979,7 @@ expr_t* warlock_t::create_expression( action_t* a, const std::string& name_str )
           virtual double evaluate() override
           {
               double t = 150000;
-              for(auto& pet : player.warlock_pet_list.dreadstalkers)
+              for(auto pet : *player.warlock_pet_list.dreadstalkers)
               {
                   if(!pet->is_sleeping() & !pet->buffs.demonic_empowerment->up())
                   {
@@ -8130,7 +8087,7 @@ expr_t* warlock_t::create_expression( action_t* a, const std::string& name_str )
       virtual double evaluate() override
       {
         double t = 5000;
-        for( auto& pet : player.warlock_pet_list.wild_imps )
+        for( auto pet : *player.warlock_pet_list.wild_imps )
         {
           if( !pet -> is_sleeping() )
           {
@@ -8192,7 +8149,7 @@ expr_t* warlock_t::create_expression( action_t* a, const std::string& name_str )
               virtual double evaluate() override
               {
                   double t = 5000;
-                  for(auto& pet : player.warlock_pet_list.dreadstalkers)
+                  for(auto pet : *player.warlock_pet_list.dreadstalkers)
                   {
                       if( !pet->is_sleeping() )
                       {
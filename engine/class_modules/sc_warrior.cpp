@@ -76,6 +76,12 @@ struct counter_t
     value += other.value;
     interval += other.interval;
   }
+
+  void serialize( archive_t& ar )
+  {
+    ar.add( value );
+    ar.add( interval );
+  }
 };
 
 struct warrior_t: public player_t
@@ -604,6 +610,7 @@ public:
   void       target_mitigation( school_e, dmg_e, action_state_t* ) override;
   void       copy_from( player_t* ) override;
   void       merge( player_t& ) override;
+  void       serialize( archive_t& ar ) override;
 
   void     datacollection_begin() override;
   void     datacollection_end() override;
@@ -5082,6 +5089,19 @@ void warrior_t::merge( player_t& other )
   }
 }
 
+// warrior_t::serialize ====================================================
+
+void warrior_t::serialize( archive_t& ar )
+{
+  player_t::serialize( ar );
+
+  ar.sequence( counters, []( archive_t& a, counter_t* c ) { c -> serialize( a ); } );
+
+  auto waste = []( archive_t& a, data_t* d ) { a.merge( d -> second ); };
+  ar.sequence( cd_waste_exec, waste );
+  ar.sequence( cd_waste_cumulative, waste );
+}
+
 // warrior_t::datacollection_begin ===========================================
 
 void warrior_t::datacollection_begin()
@@ -51,7 +51,8 @@ pet_t::pet_t( sim_t*             s,
               bool               g,
               bool               d ) :
   player_t( s, g ? PLAYER_GUARDIAN : PLAYER_PET, n, RACE_NONE ),
-  owner( o ), summoned( false ), dynamic( d ), pet_type( PET_NONE ),
+  owner( o ), summoned( false ), dynamic( d ), spawner( nullptr ),
+  pet_type( PET_NONE ),
   owner_coeff( owner_coefficients_t() )
 {
   init_pet_t_();
@@ -64,7 +65,8 @@ pet_t::pet_t( sim_t*             s,
               bool               g,
               bool               d ) :
   player_t( s, pt == PET_ENEMY ? ENEMY_ADD : g ? PLAYER_GUARDIAN : PLAYER_PET, n, RACE_NONE ),
-  owner( o ), summoned( false ), dynamic( d ), pet_type( pt ),
+  owner( o ), summoned( false ), dynamic( d ), spawner( nullptr ),
+  pet_type( pt ),
   owner_coeff( owner_coefficients_t() )
 {
   init_pet_t_();
@@ -344,3 +346,113 @@ double pet_t::composite_player_critical_damage_multiplier( const action_state_t*
 
   return m;
 }
+
+// ==========================================================================
+// Pet Spawner
+// ==========================================================================
+
+// pet_spawner_base_t::pet_spawner_base_t ===================================
+
+pet_spawner_base_t::pet_spawner_base_t( player_t* owner, const std::string& name, const creator_fn_t& creator,
+                                        size_t n_pets ) :
+  m_owner( owner ), m_name( name ), m_creator( creator )
+{
+  assert( n_pets > 0 );
+
+  owner -> pet_spawners.push_back( this );
+
+  for ( size_t i = 0; i < n_pets; ++i )
+  {
+    create();
+  }
+}
+
+// pet_spawner_base_t::create ===============================================
+
+pet_t* pet_spawner_base_t::create()
+{
+  pet_t* pet = m_creator( m_owner );
+  pet -> spawner = this;
+
+  // The pool is reported as a single pet
+  if ( ! m_pets.empty() )
+  {
+    pet -> quiet = true;
+  }
+
+  pet -> callbacks_on_demise.push_back( [ this ]( player_t* p ) { release( p -> cast_pet() ); } );
+
+  m_pets.push_back( pet );
+
+  return pet;
+}
+
+// pet_spawner_base_t::release ==============================================
+
+void pet_spawner_base_t::release( pet_t* pet )
+{
+  // Active pets are kept in summon order
+  auto it = range::find( m_active, pet );
+  if ( it != m_active.end() )
+  {
+    m_active.erase( it );
+  }
+
+  m_free.push_back( pet );
+}
+
+// pet_spawner_base_t::acquire ==============================================
+
+pet_t* pet_spawner_base_t::acquire()
+{
+  pet_t* pet = nullptr;
+
+  while ( ! pet && ! m_free.empty() )
+  {
+    // Skip pets that were summoned without the spawner
+    if ( m_free.back() -> is_sleeping() )
+    {
+      pet = m_free.back();
+    }
+    m_free.pop_back();
+  }
+
+  // An exhausted pool summons the longest active pet again
+  if ( ! pet && ! m_active.empty() )
+  {
+    pet = m_active.front();
+    m_active.erase( m_active.begin() );
+  }
+  // All pets were summoned without the spawner
+  else if ( ! pet )
+  {
+    pet = m_pets.front();
+  }
+
+  m_active.push_back( pet );
+
+  // Statistics of the whole pool are collected through the first pet
+  m_pets.front() -> active_during_iteration = true;
+
+  return pet;
+}
+
+// pet_spawner_base_t::spawn ================================================
+
+pet_t* pet_spawner_base_t::spawn( timespan_t duration )
+{
+  pet_t* pet = acquire();
+  pet -> summon( duration );
+
+  return pet;
+}
+
+// pet_spawner_base_t::reset ================================================
+
+void pet_spawner_base_t::reset()
+{
+  m_active.clear();
+
+  // Pets are taken from the back, start each iteration with the first pet of the pool
+  m_free.assign( m_pets.rbegin(), m_pets.rend() );
+}
@@ -746,6 +746,7 @@ player_t::player_t( sim_t*             s,
   collected_data( this ),
   // Damage
   iteration_dmg( 0 ), priority_iteration_dmg( 0 ), iteration_dmg_taken( 0 ),
+  iteration_crit_luck( 0 ),
   dpr( 0 ),
   dps_convergence( 0 ),
   // Heal
@@ -1585,6 +1586,7 @@ void player_t::init_resources( bool force )
         if ( resources.max[ i ] > 0 )
         {
           collected_data.resource_timelines.push_back( player_collected_data_t::resource_timeline_t( i ) );
+          collected_data.resource_timelines.back().timeline.reserve( timespan_t::from_seconds( sim -> expected_max_time() ) );
         }
       }
     }
@@ -2496,7 +2498,7 @@ void player_t::init_assessors()
     proc_types pt = state -> proc_type();
     proc_types2 pt2 = state -> impact_proc_type2();
     if ( pt != PROC1_INVALID && pt2 != PROC2_INVALID )
-      action_callback_t::trigger( callbacks.procs[ pt ][ pt2 ], state -> action, state );
+      callbacks.trigger( pt, pt2, state -> action, state );
 
     return assessor::CONTINUE;
   } );
@@ -3794,10 +3796,7 @@ void player_t::sequence_add_wait( const timespan_t& amount, const timespan_t& ts
     {
       if ( in_combat )
       {
-        if ( collected_data.action_sequence.size() && collected_data.action_sequence.back() -> wait_time > timespan_t::zero() )
-          collected_data.action_sequence.back() -> wait_time += amount;
-        else
-          collected_data.action_sequence.push_back( new player_collected_data_t::action_sequence_data_t( ts, amount, this ) );
+        collected_data.action_sequence.add_wait( amount, ts, this );
       }
     }
     else
@@ -3817,9 +3816,9 @@ void player_t::sequence_add( const action_t* a, const player_t* target, const ti
     if ( collected_data.action_sequence.size() <= sim -> expected_max_time() * 2.0 + 3.0 )
     {
       if ( in_combat )
-        collected_data.action_sequence.push_back( new player_collected_data_t::action_sequence_data_t( a, target, ts, this ) );
+        collected_data.action_sequence.add( a, target, ts, this );
       else
-        collected_data.action_sequence_precombat.push_back( new player_collected_data_t::action_sequence_data_t( a, target, ts, this ) );
+        collected_data.action_sequence_precombat.add( a, target, ts, this );
     }
     else
     {
@@ -3969,6 +3968,7 @@ void player_t::datacollection_begin()
   iteration_absorb = 0.0;
   iteration_absorb_taken = 0.0;
   iteration_dmg_taken = 0;
+  iteration_crit_luck = 0;
   iteration_heal_taken = 0;
   active_during_iteration = false;
 
@@ -4185,6 +4185,10 @@ void player_t::merge( player_t& other )
 
   buff_merge::merge( *this, other );
 
+#ifdef CALLBACK_STATS
+  callbacks.merge( other.callbacks );
+#endif
+
   // Procs
   for ( size_t i = 0; i < proc_list.size(); ++i )
   {
@@ -4218,7 +4222,12 @@ void player_t::merge( player_t& other )
   {
     stats_t& stats = *stats_list[ i ];
     if ( stats_t* other_stats = other.find_stats( stats.name_str ) )
+    {
+      // Results of the last iteration, if it did not collect data
+      stats.fold_results();
+      other_stats -> fold_results();
       stats.merge( *other_stats );
+    }
     else
     {
 #ifndef NDEBUG
@@ -4294,6 +4303,52 @@ void player_t::merge( player_t& other )
   }
 }
 
+// player_t::serialize ======================================================
+
+void player_t::serialize( archive_t& ar )
+{
+  collected_data.serialize( ar );
+
+  // Buffs are identified like in merge, by name and source actor
+  auto buff_key = []( const buff_t* b ) -> std::string {
+    if ( ! b -> source || b -> source == b -> player )
+      return b -> name_str;
+    return b -> name_str + "@" + util::to_string( b -> source -> index );
+  };
+
+  std::unordered_map<std::string, buff_t*> buffs;
+  if ( ar.loading() )
+  {
+    for ( auto b : buff_list )
+      buffs[ buff_key( b ) ] = b;
+  }
+
+  ar.objects( buff_list, buff_key, [ &buffs ]( const std::string& key ) {
+    auto it = buffs.find( key );
+    return it != buffs.end() ? it -> second : nullptr;
+  } );
+
+  ar.objects( proc_list, []( const proc_t* p ) { return p -> name_str; },
+              [ this ]( const std::string& n ) { return find_proc( n ); } );
+  ar.objects( gain_list, []( const gain_t* g ) { return g -> name_str; },
+              [ this ]( const std::string& n ) { return find_gain( n ); } );
+  ar.objects( stats_list, []( const stats_t* s ) { return s -> name_str; },
+              [ this ]( const std::string& n ) { return find_stats( n ); } );
+  ar.objects( uptime_list, []( const uptime_t* u ) { return u -> name_str; },
+              [ this ]( const std::string& n ) { return find_uptime( n ); } );
+  ar.objects( benefit_list, []( const benefit_t* b ) { return b -> name_str; },
+              [ this ]( const std::string& n ) { return find_benefit( n ); } );
+  ar.objects( sample_data_list, []( const luxurious_sample_data_t* sd ) { return sd -> name_str; },
+              [ this ]( const std::string& n ) { return find_sample_data( n ); } );
+
+  ar.sequence( action_list, []( archive_t& a, action_t* action ) { a.add( action -> total_executions ); } );
+
+#ifdef CALLBACK_STATS
+  ar.add( callbacks.n_evaluated );
+  ar.add( callbacks.n_triggered );
+#endif
+}
+
 // player_t::reset ==========================================================
 
 void player_t::reset()
@@ -4308,6 +4363,9 @@ void player_t::reset()
   // Reset current stats to initial stats
   current = initial;
 
+  // Stat perturbation of scale factor regression simulations
+  sim -> scaling -> perturb( this );
+
   current.sleeping = true;
 
   change_position( initial.position );
@@ -4381,6 +4439,11 @@ void player_t::reset()
 
   range::for_each( shuffled_rng_list, [](shuffled_rng_t* shuffled_rng) { shuffled_rng->reset(); });
 
+  // Pets created by the spawners are reset along with the rest of the pets, after the owner
+  range::for_each( pet_spawners, []( pet_spawner_base_t* spawner ) { spawner -> reset(); } );
+
+  dot_tick_batches.clear();
+
   potion_used = 0;
 
   item_cooldown.reset( false );
@@ -5833,7 +5896,7 @@ void player_t::do_damage( action_state_t* incoming_state )
     // On damage/heal in. Proc flags are arranged as such that the "incoming"
     // version of the primary proc flag is always follows the outgoing version.
     if ( pt != PROC1_INVALID && pt2 != PROC2_INVALID )
-      action_callback_t::trigger( callbacks.procs[pt + 1][pt2], incoming_state -> action, incoming_state );
+      callbacks.trigger( static_cast<proc_types>( pt + 1 ), pt2, incoming_state -> action, incoming_state );
   }
 
   // Check if target is dying
@@ -5996,14 +6059,13 @@ bool player_t::recent_cast()
 dot_t* player_t::find_dot( const std::string& name,
                            player_t* source ) const
 {
-  for ( size_t i = 0; i < dot_list.size(); ++i )
-  {
-    dot_t* d = dot_list[ i ];
-    if ( d -> source == source &&
-         d -> name_str == name )
-      return d;
-  }
-  return 0;
+  return find_dot( symbol::find( name ), source );
+}
+
+dot_t* player_t::find_dot( symbol_t name,
+                           player_t* source ) const
+{
+  return dot_index.find( name, source );
 }
 
 // player_t::clear_action_priority_lists() ==================================
@@ -6060,10 +6122,10 @@ stats_t* player_t::find_stats( const std::string& name ) const
 { return find_vector_member( stats_list, name ); }
 
 gain_t* player_t::find_gain ( const std::string& name ) const
-{ return find_vector_member( gain_list, name ); }
+{ return gain_index.find( symbol::find( name ) ); }
 
 proc_t* player_t::find_proc ( const std::string& name ) const
-{ return find_vector_member( proc_list, name ); }
+{ return proc_index.find( symbol::find( name ) ); }
 
 luxurious_sample_data_t* player_t::find_sample_data( const std::string& name ) const
 { return find_vector_member( sample_data_list, name ); }
@@ -6075,7 +6137,10 @@ uptime_t* player_t::find_uptime ( const std::string& name ) const
 { return find_vector_member( uptime_list, name ); }
 
 cooldown_t* player_t::find_cooldown( const std::string& name ) const
-{ return find_vector_member( cooldown_list, name ); }
+{ return find_cooldown( symbol::find( name ) ); }
+
+cooldown_t* player_t::find_cooldown( symbol_t name ) const
+{ return cooldown_index.find( name ); }
 
 action_t* player_t::find_action( const std::string& name ) const
 { return find_vector_member( action_list, name ); }
@@ -6084,13 +6149,15 @@ action_t* player_t::find_action( const std::string& name ) const
 
 cooldown_t* player_t::get_cooldown( const std::string& name )
 {
-  cooldown_t* c = find_cooldown( name );
+  symbol_t symbol = symbol::intern( name );
+  cooldown_t* c = find_cooldown( symbol );
 
   if ( !c )
   {
     c = new cooldown_t( name, *this );
 
     cooldown_list.push_back( c );
+    cooldown_index.insert( symbol, c );
   }
 
   return c;
@@ -6155,13 +6222,20 @@ shuffled_rng_t* player_t::get_shuffled_rng(const std::string& name, int success_
 
 dot_t* player_t::get_dot( const std::string& name,
                           player_t* source )
+{
+  return get_dot( symbol::intern( name ), source );
+}
+
+dot_t* player_t::get_dot( symbol_t name,
+                          player_t* source )
 {
   dot_t* d = find_dot( name, source );
 
   if ( ! d )
   {
-    d = new dot_t( name, this, source );
+    d = new dot_t( symbol::name( name ), this, source );
     dot_list.push_back( d );
+    dot_index.insert( name, d, source );
   }
 
   return d;
@@ -6171,13 +6245,15 @@ dot_t* player_t::get_dot( const std::string& name,
 
 gain_t* player_t::get_gain( const std::string& name )
 {
-  gain_t* g = find_gain( name );
+  symbol_t symbol = symbol::intern( name );
+  gain_t* g = gain_index.find( symbol );
 
   if ( !g )
   {
     g = new gain_t( name );
 
     gain_list.push_back( g );
+    gain_index.insert( symbol, g );
   }
 
   return g;
@@ -6187,13 +6263,15 @@ gain_t* player_t::get_gain( const std::string& name )
 
 proc_t* player_t::get_proc( const std::string& name )
 {
-  proc_t* p = find_proc( name );
+  symbol_t symbol = symbol::intern( name );
+  proc_t* p = proc_index.find( symbol );
 
   if ( !p )
   {
     p = new proc_t( *sim, name );
 
     proc_list.push_back( p );
+    proc_index.insert( symbol, p );
   }
 
   return p;
@@ -6219,6 +6297,12 @@ luxurious_sample_data_t* player_t::get_sample_data( const std::string& name )
 
 stats_t* player_t::get_stats( const std::string& n, action_t* a )
 {
+  // Pets of a pet spawner share the statistics of the first pet of the spawner
+  if ( is_pet() && cast_pet() -> spawner && cast_pet() -> spawner -> pets().front() != this )
+  {
+    return cast_pet() -> spawner -> pets().front() -> get_stats( n, a );
+  }
+
   stats_t* stats = find_stats( n );
 
   if ( ! stats )
@@ -11080,126 +11164,315 @@ double player_stat_cache_t::player_heal_multiplier( const action_state_t* s ) co
 
 #endif
 
-player_collected_data_t::action_sequence_data_t::action_sequence_data_t( const action_t* a, const player_t* t, const timespan_t& ts, const player_t* p ) :
-  action( a ), target( t ), time( ts ), wait_time( timespan_t::zero() )
+player_collected_data_t::action_sequence_data_t::action_sequence_data_t( const action_t* a, const player_t* t, const timespan_t& ts, const timespan_t& wait ) :
+  action( a ), target( t ), time( ts ), wait_time( wait )
+{
+  range::fill( resource_snapshot, -1 );
+  range::fill( resource_max_snapshot, -1 );
+}
+
+void player_collected_data_t::action_sequence_t::reserve( size_t n )
 {
-  for ( size_t i = 0; i < p -> buff_list.size(); ++i )
+  records.reserve( n );
+  buffs.reserve( n * 8 );
+  resources.reserve( n * 2 );
+}
+
+void player_collected_data_t::action_sequence_t::clear()
+{
+  records.clear();
+  buffs.clear();
+  cooldowns.clear();
+  targets.clear();
+  resources.clear();
+}
+
+void player_collected_data_t::action_sequence_t::snapshot_buffs( const player_t* p )
+{
+  bool remains = p -> sim -> json_full_states != 0;
+  for ( buff_t* b : p -> buff_list )
   {
-    buff_t* b = p -> buff_list[ i ];
-    if( b -> check() && !b -> quiet && !b -> constant )
+    if ( b -> check() && ! b -> quiet && ! b -> constant )
     {
-      std::vector<double> buff_args;
-      buff_args.push_back( b -> check() );
-      if( p -> sim -> json_full_states ) {
-        buff_args.push_back( b -> remains().total_seconds() );
-      }
-      buff_list.push_back( std::make_pair( b, buff_args ) );
+      buffs.push_back( buff_record_t { b, b -> check(), remains ? b -> remains().total_seconds() : 0.0 } );
     }
   }
+}
+
+void player_collected_data_t::action_sequence_t::snapshot( record_t& record, const player_t* p )
+{
+  record.full_state = p -> sim -> json_full_states != 0;
+
+  record.buff_begin = as<uint32_t>( buffs.size() );
+  snapshot_buffs( p );
+  record.buff_end = as<uint32_t>( buffs.size() );
 
-  // Adding cooldown and debuffs snapshots if asking for json full states
-  if ( p -> sim -> json_full_states ) {
-    for ( size_t i = 0; i < p -> cooldown_list.size(); ++i )
+  record.cooldown_begin = as<uint32_t>( cooldowns.size() );
+  record.target_begin = as<uint32_t>( targets.size() );
+  if ( record.full_state )
+  {
+    for ( cooldown_t* c : p -> cooldown_list )
     {
-      cooldown_t* c = p -> cooldown_list[ i ];
       if ( c -> down() )
       {
-        std::vector<double> cooldown_args;
-        cooldown_args.push_back( c -> charges );
-        cooldown_args.push_back( c -> remains().total_seconds() );
-        cooldown_list.push_back( std::make_pair( c, cooldown_args ) );
+        cooldowns.push_back( cooldown_record_t { c, c -> charges, c -> remains().total_seconds() } );
       }
     }
+
     for ( player_t* current_target : p -> sim -> target_list )
     {
-      std::vector< std::pair< buff_t*, std::vector<double> > > debuff_list;
-      for ( size_t i = 0; i < current_target -> buff_list.size(); ++i )
-      {
-        buff_t* d = current_target -> buff_list[ i ];
-        if ( d -> check() && !d -> quiet && !d -> constant )
-        {
-          std::vector<double> debuff_args;
-          debuff_args.push_back( d -> check() );
-          debuff_args.push_back( d -> remains().total_seconds() );
-          debuff_list.push_back( std::make_pair( d, debuff_args ) );
-        }
-      }
-      target_list.push_back( std::make_pair( current_target, debuff_list ) );
+      target_record_t target_record { current_target, as<uint32_t>( buffs.size() ), 0 };
+      snapshot_buffs( current_target );
+      target_record.debuff_end = as<uint32_t>( buffs.size() );
+      targets.push_back( target_record );
     }
   }
+  record.cooldown_end = as<uint32_t>( cooldowns.size() );
+  record.target_end = as<uint32_t>( targets.size() );
 
-  range::fill( resource_snapshot, -1 );
-  range::fill( resource_max_snapshot, -1 );
-
+  record.resource_begin = as<uint32_t>( resources.size() );
   for ( resource_e i = RESOURCE_HEALTH; i < RESOURCE_MAX; ++i )
   {
     if ( p -> resources.max[ i ] > 0.0 )
     {
-      resource_snapshot[ i ] = p -> resources.current[ i ];
-      resource_max_snapshot[ i ] = p -> resources.max[ i ];
+      resources.push_back( resource_record_t { i, p -> resources.current[ i ], p -> resources.max[ i ] } );
     }
   }
+  record.resource_end = as<uint32_t>( resources.size() );
+}
+
+void player_collected_data_t::action_sequence_t::add( const action_t* a, const player_t* target, const timespan_t& ts, const player_t* p )
+{
+  record_t record;
+  record.action = a;
+  record.target = target;
+  record.time = ts;
+  record.wait_time = timespan_t::zero();
+  snapshot( record, p );
+  records.push_back( record );
+}
+
+void player_collected_data_t::action_sequence_t::add_wait( const timespan_t& amount, const timespan_t& ts, const player_t* p )
+{
+  if ( ! records.empty() && records.back().wait_time > timespan_t::zero() )
+  {
+    records.back().wait_time += amount;
+    return;
+  }
+
+  record_t record;
+  record.action = nullptr;
+  record.target = nullptr;
+  record.time = ts;
+  record.wait_time = amount;
+  snapshot( record, p );
+  records.push_back( record );
 }
 
-player_collected_data_t::action_sequence_data_t::action_sequence_data_t( const timespan_t& ts, const timespan_t& wait, const player_t* p ) :
-  action( 0 ), target( 0 ), time( ts ), wait_time( wait )
+void player_collected_data_t::action_sequence_t::decode_buffs( uint32_t begin, uint32_t end, bool remains,
+    std::vector< std::pair< buff_t*, std::vector<double> > >& out ) const
 {
-  for ( size_t i = 0; i < p -> buff_list.size(); ++i )
+  for ( uint32_t i = begin; i < end; ++i )
   {
-    buff_t* b = p -> buff_list[ i ];
-    if( b -> check() && !b -> quiet && !b -> constant )
+    std::vector<double> args;
+    args.push_back( buffs[ i ].stacks );
+    if ( remains )
     {
-      std::vector<double> buff_args;
-      buff_args.push_back( b -> check() );
-      if( p -> sim -> json_full_states ) {
-        buff_args.push_back( b -> remains().total_seconds() );
-      }
-      buff_list.push_back( std::make_pair( b, buff_args ) );
+      args.push_back( buffs[ i ].remains );
     }
+    out.push_back( std::make_pair( buffs[ i ].buff, args ) );
   }
+}
+
+std::vector<player_collected_data_t::action_sequence_data_t> player_collected_data_t::action_sequence_t::decode() const
+{
+  std::vector<action_sequence_data_t> sequence;
+  sequence.reserve( records.size() );
+
+  for ( const auto& record : records )
+  {
+    sequence.push_back( action_sequence_data_t( record.action, record.target, record.time, record.wait_time ) );
+    auto& data = sequence.back();
 
-  // Adding cooldown and debuffs snapshots if asking for json full states
-  if ( p -> sim -> json_full_states ) {
-    for ( size_t i = 0; i < p -> cooldown_list.size(); ++i )
+    decode_buffs( record.buff_begin, record.buff_end, record.full_state, data.buff_list );
+
+    for ( uint32_t i = record.cooldown_begin; i < record.cooldown_end; ++i )
     {
-      cooldown_t* c = p -> cooldown_list[ i ];
-      if ( c -> down() )
-      {
-        std::vector<double> cooldown_args;
-        cooldown_args.push_back( c -> charges );
-        cooldown_args.push_back( c -> remains().total_seconds() );
-        cooldown_list.push_back( std::make_pair( c, cooldown_args ) );
-      }
+      std::vector<double> args;
+      args.push_back( cooldowns[ i ].charges );
+      args.push_back( cooldowns[ i ].remains );
+      data.cooldown_list.push_back( std::make_pair( cooldowns[ i ].cooldown, args ) );
     }
-    for ( player_t* current_target : p -> sim -> target_list )
+
+    for ( uint32_t i = record.target_begin; i < record.target_end; ++i )
     {
       std::vector< std::pair< buff_t*, std::vector<double> > > debuff_list;
-      for ( size_t i = 0; i < current_target -> buff_list.size(); ++i )
+      decode_buffs( targets[ i ].debuff_begin, targets[ i ].debuff_end, true, debuff_list );
+      data.target_list.push_back( std::make_pair( targets[ i ].target, debuff_list ) );
+    }
+
+    for ( uint32_t i = record.resource_begin; i < record.resource_end; ++i )
+    {
+      data.resource_snapshot[ resources[ i ].resource ] = resources[ i ].current;
+      data.resource_max_snapshot[ resources[ i ].resource ] = resources[ i ].max;
+    }
+  }
+
+  return sequence;
+}
+
+void player_collected_data_t::action_sequence_t::save( archive_t& ar, const player_t* p ) const
+{
+  // Index of a buff in the buff list of its actor
+  std::unordered_map<const buff_t*, uint32_t> buff_index;
+  auto index_of = [ &buff_index ]( const buff_t* b ) {
+    auto it = buff_index.find( b );
+    if ( it != buff_index.end() )
+    {
+      return it -> second;
+    }
+
+    const auto& list = b -> player -> buff_list;
+    auto idx = as<uint32_t>( range::find_if( list, [ b ]( const buff_t* other ) { return other == b; } ) - list.begin() );
+    buff_index[ b ] = idx;
+    return idx;
+  };
+
+  auto save_buffs = [ &ar, &index_of, this ]( uint32_t begin, uint32_t end ) {
+    ar.write( end - begin );
+    for ( uint32_t i = begin; i < end; ++i )
+    {
+      ar.write( buffs[ i ].buff -> player -> index );
+      ar.write( index_of( buffs[ i ].buff ) );
+      ar.write( buffs[ i ].stacks );
+      ar.write( buffs[ i ].remains );
+    }
+  };
+
+  ar.write( static_cast<uint64_t>( records.size() ) );
+  for ( const auto& record : records )
+  {
+    int action = -1;
+    if ( record.action )
+    {
+      auto it = range::find_if( p -> action_list, [ &record ]( const action_t* a ) { return a == record.action; } );
+      action = as<int>( it - p -> action_list.begin() );
+    }
+
+    ar.write( action );
+    ar.write( record.target ? record.target -> index : -1 );
+    ar.write( static_cast<int64_t>( timespan_t::to_native( record.time ) ) );
+    ar.write( static_cast<int64_t>( timespan_t::to_native( record.wait_time ) ) );
+    ar.write( record.full_state );
+
+    save_buffs( record.buff_begin, record.buff_end );
+
+    ar.write( record.cooldown_end - record.cooldown_begin );
+    for ( uint32_t i = record.cooldown_begin; i < record.cooldown_end; ++i )
+    {
+      ar.write( as<uint32_t>( range::find( p -> cooldown_list, cooldowns[ i ].cooldown ) - p -> cooldown_list.begin() ) );
+      ar.write( cooldowns[ i ].charges );
+      ar.write( cooldowns[ i ].remains );
+    }
+
+    ar.write( record.target_end - record.target_begin );
+    for ( uint32_t i = record.target_begin; i < record.target_end; ++i )
+    {
+      ar.write( targets[ i ].target -> index );
+      save_buffs( targets[ i ].debuff_begin, targets[ i ].debuff_end );
+    }
+
+    ar.write( record.resource_end - record.resource_begin );
+    for ( uint32_t i = record.resource_begin; i < record.resource_end; ++i )
+    {
+      ar.write( resources[ i ].resource );
+      ar.write( resources[ i ].current );
+      ar.write( resources[ i ].max );
+    }
+  }
+}
+
+// Entries referring to actions or actors that do not exist in the loading simulation (e.g., pets
+// created during the simulation) are skipped
+void player_collected_data_t::action_sequence_t::load( archive_t& ar, const player_t* p )
+{
+  const sim_t& sim = *p -> sim;
+
+  auto load_buffs = [ &ar, &sim, this ]() {
+    for ( auto n = ar.read<uint32_t>(); n > 0; --n )
+    {
+      const player_t* owner = sim.find_player( ar.read<int>() );
+      auto idx = ar.read<uint32_t>();
+      auto stacks = ar.read<int>();
+      auto remains = ar.read<double>();
+      if ( owner && idx < owner -> buff_list.size() )
       {
-        buff_t* d = current_target -> buff_list[ i ];
-        if ( d -> check() && !d -> quiet && !d -> constant )
-        {
-          std::vector<double> debuff_args;
-          debuff_args.push_back( d -> check() );
-          debuff_args.push_back( d -> remains().total_seconds() );
-          debuff_list.push_back( std::make_pair( d, debuff_args ) );
-        }
+        buffs.push_back( buff_record_t { owner -> buff_list[ idx ], stacks, remains } );
       }
-      target_list.push_back( std::make_pair( current_target, debuff_list ) );
     }
-  }
+  };
 
-  range::fill( resource_snapshot, -1 );
-  range::fill( resource_max_snapshot, -1 );
+  clear();
 
-  for ( resource_e i = RESOURCE_HEALTH; i < RESOURCE_MAX; ++i )
+  for ( auto n = ar.read<uint64_t>(); n > 0; --n )
   {
-    if ( p -> resources.max[ i ] > 0.0 )
+    record_t record;
+    auto action = ar.read<int>();
+    auto target = ar.read<int>();
+    record.action = action >= 0 && as<size_t>( action ) < p -> action_list.size() ? p -> action_list[ action ] : nullptr;
+    record.target = target >= 0 ? sim.find_player( target ) : nullptr;
+    record.time = timespan_t::from_native( ar.read<int64_t>() );
+    record.wait_time = timespan_t::from_native( ar.read<int64_t>() );
+    record.full_state = ar.read<bool>();
+
+    record.buff_begin = as<uint32_t>( buffs.size() );
+    load_buffs();
+    record.buff_end = as<uint32_t>( buffs.size() );
+
+    record.cooldown_begin = as<uint32_t>( cooldowns.size() );
+    for ( auto i = ar.read<uint32_t>(); i > 0; --i )
     {
-      resource_snapshot[ i ] = p -> resources.current[ i ];
-      resource_max_snapshot[ i ] = p -> resources.max[ i ];
+      auto idx = ar.read<uint32_t>();
+      auto charges = ar.read<int>();
+      auto remains = ar.read<double>();
+      if ( idx < p -> cooldown_list.size() )
+      {
+        cooldowns.push_back( cooldown_record_t { p -> cooldown_list[ idx ], charges, remains } );
+      }
+    }
+    record.cooldown_end = as<uint32_t>( cooldowns.size() );
 
+    record.target_begin = as<uint32_t>( targets.size() );
+    for ( auto i = ar.read<uint32_t>(); i > 0; --i )
+    {
+      player_t* t = sim.find_player( ar.read<int>() );
+      target_record_t target_record { t, as<uint32_t>( buffs.size() ), 0 };
+      load_buffs();
+      target_record.debuff_end = as<uint32_t>( buffs.size() );
+      if ( t )
+      {
+        targets.push_back( target_record );
+      }
+    }
+    record.target_end = as<uint32_t>( targets.size() );
+
+    record.resource_begin = as<uint32_t>( resources.size() );
+    for ( auto i = ar.read<uint32_t>(); i > 0; --i )
+    {
+      resource_record_t resource;
+      resource.resource = ar.read<resource_e>();
+      resource.current = ar.read<double>();
+      resource.max = ar.read<double>();
+      resources.push_back( resource );
+    }
+    record.resource_end = as<uint32_t>( resources.size() );
+
+    if ( action >= 0 && ( ! record.action || ! record.target ) )
+    {
+      continue;
     }
+
+    records.push_back( record );
   }
 }
 
@@ -11254,6 +11527,8 @@ player_collected_data_t::player_collected_data_t( const player_t* player ) :
   effective_theck_meloree_index( player -> name_str + "Theck-Meloree Index (Effective)", tank_container_type( player, 2 ) ),
   max_spike_amount( player -> name_str + " Max Spike Value", tank_container_type( player, 2 ) ),
   target_metric( player -> name_str + " Target Metric", player -> sim -> statistics_level < 1 ),
+  target_metric_crit_luck( player -> name_str + " Target Metric Crit Luck", false ),
+  target_metric_combat_length( player -> name_str + " Target Metric Combat Length", false ),
   resource_timelines(),
   combat_end_resource(
       ( ! player -> is_enemy() && ( ! player -> is_pet() || player -> sim -> report_pets_separately ) )
@@ -11305,6 +11580,22 @@ void player_collected_data_t::reserve_memory( const player_t& p )
     effective_theck_meloree_index.reserve( size );
     p.sim -> num_tanks++;
   }
+
+  // Timelines are added to on every damage, healing and resource event, preallocate them for the
+  // expected fight length so that the collection does not need to reallocate
+  auto max_time = timespan_t::from_seconds( p.sim -> expected_max_time() );
+  timeline_dmg.reserve( max_time );
+  timeline_dmg_taken.reserve( max_time );
+  timeline_healing_taken.reserve( max_time );
+  range::for_each( stat_timelines, [ max_time ]( stat_timeline_t& tl ) { tl.timeline.reserve( max_time ); } );
+
+  if ( health_changes.collect )
+  {
+    health_changes.timeline.reserve( max_time );
+    health_changes.timeline_normalized.reserve( max_time );
+    health_changes_tmi.timeline.reserve( max_time );
+    health_changes_tmi.timeline_normalized.reserve( max_time );
+  }
 }
 
 void player_collected_data_t::merge( const player_collected_data_t& other )
@@ -11369,6 +11660,52 @@ void player_collected_data_t::merge( const player_collected_data_t& other )
   health_changes_tmi.merged_timeline.merge( other.health_changes_tmi.merged_timeline );
 }
 
+void player_collected_data_t::serialize( archive_t& ar )
+{
+  ar.add( total_iterations );
+
+  ar.merge( fight_length );
+  ar.merge( waiting_time );
+  ar.merge( executed_foreground_actions );
+  // DMG
+  ar.merge( dmg );
+  ar.merge( compound_dmg );
+  ar.merge( dps );
+  ar.merge( prioritydps );
+  ar.merge( dtps );
+  ar.merge( dpse );
+  ar.merge( dmg_taken );
+  ar.merge( timeline_dmg );
+  // HEAL
+  ar.merge( heal );
+  ar.merge( compound_heal );
+  ar.merge( hps );
+  ar.merge( htps );
+  ar.merge( hpse );
+  ar.merge( heal_taken );
+  // Tank
+  ar.merge( deaths );
+  ar.merge( timeline_dmg_taken );
+  ar.merge( timeline_healing_taken );
+  ar.merge( theck_meloree_index );
+  ar.merge( effective_theck_meloree_index );
+
+  auto leaf = []( archive_t& a, simple_sample_data_t& sd ) { a.merge( sd ); };
+  ar.sequence( resource_lost, leaf );
+  ar.sequence( resource_gained, leaf );
+  ar.sequence( resource_timelines, []( archive_t& a, resource_timeline_t& rt ) { a.merge( rt.timeline ); } );
+  ar.sequence( stat_timelines, []( archive_t& a, stat_timeline_t& st ) { a.merge( st.timeline ); } );
+
+  ar.merge( health_changes.merged_timeline );
+  ar.merge( health_changes_tmi.merged_timeline );
+
+  // Per-thread data for target_error, not merged between threads
+  AUTO_LOCK( target_metric_mutex );
+  ar.merge( target_metric );
+  ar.merge( target_metric_crit_luck );
+  ar.merge( target_metric_combat_length );
+}
+
 void player_collected_data_t::analyze( const player_t& p )
 {
   fight_length.analyze();
@@ -11661,7 +11998,70 @@ void player_collected_data_t::collect_data( const player_t& p )
 
     AUTO_LOCK( cd.target_metric_mutex );
     cd.target_metric.add( metric );
+    if ( p.sim -> control_variates )
+    {
+      cd.target_metric_crit_luck.add( p.iteration_crit_luck );
+      cd.target_metric_combat_length.add( p.sim -> expected_iteration_time / p.sim -> max_time - 1.0 );
+    }
+  }
+}
+
+/**
+ * Control variate estimate of the target metric. The metric is regressed on the per-iteration crit
+ * luck (crits minus expected crits) and the relative combat length deviation of the iteration, both
+ * of which have an expected value of zero, so the intercept of the regression is an unbiased
+ * estimate of the mean with the variance explained by the covariates removed. Returns false if the
+ * estimate is not available, callers must hold target_metric_mutex.
+ */
+bool player_collected_data_t::control_variate_estimate( const sim_t& sim, double& mean, double& error ) const
+{
+  const std::vector<double>& y = target_metric.data();
+  size_t n = y.size();
+  if ( target_metric.simple || target_metric_crit_luck.data().size() != n ||
+       target_metric_combat_length.data().size() != n )
+  {
+    return false;
+  }
+
+  // Covariates that do not vary (e.g., the combat length without vary_combat_length) are left out
+  std::vector<const std::vector<double>*> covariates;
+  for ( const auto* sd : { &target_metric_crit_luck, &target_metric_combat_length } )
+  {
+    const std::vector<double>& data = sd -> data();
+    if ( range::find_if( data, [ &data ]( double v ) { return v != data.front(); } ) != data.end() )
+    {
+      covariates.push_back( &data );
+    }
+  }
+
+  size_t k = covariates.size() + 1;
+  if ( n <= k + 1 )
+  {
+    return false;
+  }
+
+  std::vector<double> x, w( n, 1.0 );
+  x.reserve( n * k );
+  for ( size_t i = 0; i < n; ++i )
+  {
+    x.push_back( 1.0 );
+    for ( const auto* c : covariates )
+    {
+      x.push_back( ( *c )[ i ] );
+    }
   }
+
+  std::vector<double> coefficients, inverse;
+  double variance;
+  if ( ! statistics::least_squares( x, y, w, k, coefficients, inverse, variance ) )
+  {
+    return false;
+  }
+
+  mean = coefficients[ 0 ];
+  error = sim.confidence_estimator * std::sqrt( variance * inverse[ 0 ] );
+
+  return true;
 }
 
 std::ostream& player_collected_data_t::data_str( std::ostream& s ) const
@@ -12035,6 +12435,44 @@ bool player_t::verify_use_items() const
   return missing_actions.size() == 0;
 }
 
+// player_t::fold_expressions ===============================================
+
+void player_t::fold_expressions()
+{
+  int nodes = 0;
+  for ( auto action : action_list )
+  {
+    nodes += action -> fold_expressions();
+  }
+
+  size_t lines = 0;
+  size_t removed = 0;
+  for ( auto apl : action_priority_list )
+  {
+    auto& list = apl -> foreground_action_list;
+    lines += list.size();
+
+    auto it = std::remove_if( list.begin(), list.end(), []( action_t* action ) {
+      return action -> if_expr && action -> if_expr -> always_false();
+    } );
+    removed += std::distance( it, list.end() );
+    list.erase( it, list.end() );
+  }
+
+  if ( sim -> debug )
+  {
+    sim -> out_debug.printf( "%s expression folding removed %u of %u action lines, %d expression nodes",
+                             name(), as<unsigned>( removed ), as<unsigned>( lines ), nodes );
+  }
+
+  // Report the main simulation only, child simulations initialize the same actors
+  if ( ! sim -> parent && ( removed > 0 || nodes > 0 ) )
+  {
+    std::cout << "Player " << name() << ": expression folding removed " << removed << " of " << lines
+              << " action lines, " << nodes << " expression nodes" << std::endl;
+  }
+}
+
 // Figure out a target out of all non-sleeping targets. Skip "invulnerable" ones for now, anything
 // else is fair game.
 //
@@ -238,6 +238,7 @@ void print_profiles( sim_t* );
 void print_text( sim_t*, bool detail );
 void print_html( sim_t& );
 void print_json( sim_t& );
+std::string json2_string( const sim_t& );
 void print_html_player( report::sc_html_stream&, player_t&, int );
 void print_xml( sim_t* );
 void print_suite( sim_t* );
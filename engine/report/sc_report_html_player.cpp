@@ -2041,6 +2041,9 @@ void print_html_player_action_priority_list( report::sc_html_stream& os,
 
   if ( !p.collected_data.action_sequence.empty() && !p.is_enemy()  )
   {
+    auto action_sequence = p.collected_data.action_sequence.decode();
+    auto action_sequence_precombat = p.collected_data.action_sequence_precombat.decode();
+
     std::vector<std::string> targets;
 
     targets.push_back( "none" );
@@ -2049,21 +2052,21 @@ void print_html_player_action_priority_list( report::sc_html_stream& os,
       targets.push_back( p.target->name() );
     }
 
-    for ( const auto& sequence_data : p.collected_data.action_sequence )
+    for ( const auto& sequence_data : action_sequence )
     {
-      if ( !sequence_data->action || !sequence_data->action->harmful )
+      if ( !sequence_data.action || !sequence_data.action->harmful )
         continue;
       bool found = false;
       for ( size_t j = 0; j < targets.size(); ++j )
       {
-        if ( targets[ j ] == sequence_data->target->name() )
+        if ( targets[ j ] == sequence_data.target->name() )
         {
           found = true;
           break;
         }
       }
       if ( !found )
-        targets.push_back( sequence_data->target->name() );
+        targets.push_back( sequence_data.target->name() );
     }
 
     // Sample Sequence (text string)
@@ -2091,15 +2094,14 @@ void print_html_player_action_priority_list( report::sc_html_stream& os,
 
     os << "</style>\n";
 
-    for ( const auto& sequence_data :
-          p.collected_data.action_sequence_precombat )
+    for ( const auto& sequence_data : action_sequence_precombat )
     {
-      print_html_sample_sequence_string_entry( os, *sequence_data, p, true );
+      print_html_sample_sequence_string_entry( os, sequence_data, p, true );
     }
 
-    for ( const auto& sequence_data : p.collected_data.action_sequence )
+    for ( const auto& sequence_data : action_sequence )
     {
-      print_html_sample_sequence_string_entry( os, *sequence_data, p );
+      print_html_sample_sequence_string_entry( os, sequence_data, p );
     }
 
     os << "\n</div>\n"
@@ -2124,15 +2126,14 @@ void print_html_player_action_priority_list( report::sc_html_stream& os,
         "<th class=\"center\">buffs</th>\n"
         "</tr>\n" );
 
-    for ( const auto& sequence_data :
-          p.collected_data.action_sequence_precombat )
+    for ( const auto& sequence_data : action_sequence_precombat )
     {
-      print_html_sample_sequence_table_entry( os, *sequence_data, p, true );
+      print_html_sample_sequence_table_entry( os, sequence_data, p, true );
     }
 
-    for ( const auto& sequence_data : p.collected_data.action_sequence )
+    for ( const auto& sequence_data : action_sequence )
     {
-      print_html_sample_sequence_table_entry( os, *sequence_data, p );
+      print_html_sample_sequence_table_entry( os, sequence_data, p );
     }
 
     // close table
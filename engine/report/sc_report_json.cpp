@@ -668,31 +668,31 @@ js::sc_js_t to_json( const player_collected_data_t::buffed_stats_t& bs )
 }
 
 void to_json( JsonOutput root,
-              const std::vector<player_collected_data_t::action_sequence_data_t*>& asd,
+              const std::vector<player_collected_data_t::action_sequence_data_t>& asd,
               const std::vector<resource_e>& relevant_resources,
               const sim_t& sim )
 {
   root.make_array();
 
-  range::for_each( asd, [ &root, &relevant_resources, &sim ]( const player_collected_data_t::action_sequence_data_t* entry ) {
+  range::for_each( asd, [ &root, &relevant_resources, &sim ]( const player_collected_data_t::action_sequence_data_t& entry ) {
     auto json = root.add();
 
-    json[ "time" ] = entry -> time;
-    if ( entry -> action )
+    json[ "time" ] = entry.time;
+    if ( entry.action )
     {
-      json[ "name" ] = entry -> action -> name();
-      json[ "target" ] = entry -> action -> target -> name();
+      json[ "name" ] = entry.action -> name();
+      json[ "target" ] = entry.action -> target -> name();
     }
     else
     {
-      json[ "wait" ] = entry -> wait_time;
+      json[ "wait" ] = entry.wait_time;
     }
 
-    if ( entry -> buff_list.size() > 0 )
+    if ( entry.buff_list.size() > 0 )
     {
       auto buffs = json[ "buffs" ];
       buffs.make_array();
-      range::for_each( entry -> buff_list, [ &buffs, &sim ]( const std::pair< buff_t*, std::vector<double> > data ) {
+      range::for_each( entry.buff_list, [ &buffs, &sim ]( const std::pair< buff_t*, std::vector<double> > data ) {
         auto entry = buffs.add();
 
         entry[ "name" ] = data.first -> name();
@@ -705,11 +705,11 @@ void to_json( JsonOutput root,
     }
 
     // Writing cooldown and debuffs data if asking for json full states
-    if ( sim.json_full_states && entry -> cooldown_list.size() > 0 )
+    if ( sim.json_full_states && entry.cooldown_list.size() > 0 )
     {
       auto cooldowns = json[ "cooldowns" ];
       cooldowns.make_array();
-      range::for_each( entry -> cooldown_list, [ &cooldowns, &sim ]( const std::pair< cooldown_t*, std::vector<double> > data ) {
+      range::for_each( entry.cooldown_list, [ &cooldowns, &sim ]( const std::pair< cooldown_t*, std::vector<double> > data ) {
         auto entry = cooldowns.add();
 
         entry[ "name" ] = data.first -> name();
@@ -718,11 +718,11 @@ void to_json( JsonOutput root,
       } );
     }
 
-    if ( sim.json_full_states && entry -> target_list.size() > 0 )
+    if ( sim.json_full_states && entry.target_list.size() > 0 )
     {
       auto targets = json[ "targets" ];
       targets.make_array();
-      range::for_each( entry -> target_list, [ json, &targets, &sim ]
+      range::for_each( entry.target_list, [ json, &targets, &sim ]
           ( const std::pair< player_t*, std::vector< std::pair< buff_t*, std::vector<double> > > > target_data ) {
         auto target_entry = targets.add();
         target_entry[ "name" ] = target_data.first -> name();
@@ -740,9 +740,9 @@ void to_json( JsonOutput root,
     auto resources = json[ "resources" ];
     auto resources_max = json[ "resources_max" ];
     range::for_each( relevant_resources, [ &resources, &resources_max, &entry ]( resource_e r ) {
-      resources[ util::resource_type_string( r ) ] = entry -> resource_snapshot[ r ];
+      resources[ util::resource_type_string( r ) ] = entry.resource_snapshot[ r ];
       // TODO: Why do we have this instead of using some static one?
-      resources_max[ util::resource_type_string( r ) ] = entry -> resource_max_snapshot[ r ];
+      resources_max[ util::resource_type_string( r ) ] = entry.resource_max_snapshot[ r ];
     } );
   } );
 }
@@ -899,12 +899,12 @@ void collected_data_to_json( JsonOutput root, const player_t& p )
 
     if ( ! cd.action_sequence_precombat.empty() )
     {
-      to_json( root[ "action_sequence_precombat" ], cd.action_sequence_precombat, relevant_resources, sim );
+      to_json( root[ "action_sequence_precombat" ], cd.action_sequence_precombat.decode(), relevant_resources, sim );
     }
 
     if ( ! cd.action_sequence.empty() )
     {
-      to_json( root[ "action_sequence" ], cd.action_sequence, relevant_resources, sim );
+      to_json( root[ "action_sequence" ], cd.action_sequence.decode(), relevant_resources, sim );
     }
 
     to_json( root[ "buffed_stats" ], cd.buffed_stats_snapshot, relevant_resources );
@@ -981,13 +981,13 @@ js::sc_js_t to_json( const player_collected_data_t& cd, const sim_t& sim )
     }
     node.set( "health_changes", to_json( cd.health_changes ) );
     node.set( "health_changes", to_json( cd.health_changes_tmi ) );
-    for ( const auto& asd : cd.action_sequence )
+    for ( const auto& asd : cd.action_sequence.decode() )
     {
-      node.add( "action_sequence", to_json( *asd ) );
+      node.add( "action_sequence", to_json( asd ) );
     }
-    for ( const auto& asd : cd.action_sequence_precombat )
+    for ( const auto& asd : cd.action_sequence_precombat.decode() )
     {
-      node.add( "action_sequence_precombat", to_json( *asd ) );
+      node.add( "action_sequence_precombat", to_json( asd ) );
     }
     node.set( "buffed_stats_snapshot", to_json( cd.buffed_stats_snapshot ) );
   }
@@ -1781,7 +1781,8 @@ js::sc_js_t get_root( const sim_t& sim )
   return root;
 }
 
-void print_json2_pretty( FILE* o, const sim_t& sim )
+template <typename T_WRITER>
+void print_json2_document( T_WRITER& writer, const sim_t& sim )
 {
   Document doc;
   Value& v = doc;
@@ -1805,10 +1806,15 @@ void print_json2_pretty( FILE* o, const sim_t& sim )
     root[ "notifications" ] = sim.error_list;
   }
 
+  doc.Accept( writer );
+}
+
+void print_json2_pretty( FILE* o, const sim_t& sim )
+{
   std::array<char, 65536> buffer;
   FileWriteStream b( o, buffer.data(), buffer.size() );
   PrettyWriter<FileWriteStream> writer( b );
-  doc.Accept( writer );
+  print_json2_document( writer, sim );
 }
 
 void print_json_pretty( FILE* o, const sim_t& sim )
@@ -1887,4 +1893,14 @@ void print_json( sim_t& sim )
   }
 }
 
+// Compact JSON v2 report of the simulation, returned as a string instead of written into a file
+std::string json2_string( const sim_t& sim )
+{
+  StringBuffer b;
+  Writer<StringBuffer> writer( b );
+  print_json2_document( writer, sim );
+
+  return std::string( b.GetString(), b.GetSize() );
+}
+
 }  // report
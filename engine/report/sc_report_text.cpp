@@ -765,13 +765,14 @@ void print_text_performance( FILE* file, sim_t* sim )
       "\nBaseline Performance:\n"
       "  RNG Engine    = %s%s\n"
       "  Iterations    = %d%s\n"
-      "  TotalEvents   = %lu\n"
-      "  MaxEventQueue = %lu\n"
+      "  TotalEvents   = %llu\n"
+      "  MaxEventQueue = %llu\n"
 #ifdef EVENT_QUEUE_DEBUG
       "  AllocEvents   = %u\n"
       "  EndInsert     = %u (%.3f%%)\n"
       "  MaxTravDepth  = %u\n"
       "  AvgTravDepth  = %.3f\n"
+      "  UnlinkEvents  = %u\n"
 #endif
       "  TargetHealth  = %.0f\n"
       "  SimSeconds    = %.0f\n"
@@ -785,8 +786,8 @@ void print_text_performance( FILE* file, sim_t* sim )
       sim->rng().name(), sim->deterministic ? " (deterministic)" : "",
       sim->iterations,
       sim -> threads > 1 ? iterations_str.str().c_str() : "",
-      sim->event_mgr.total_events_processed,
-      sim->event_mgr.max_events_remaining,
+      static_cast<unsigned long long>( sim->event_mgr.total_events_processed ),
+      static_cast<unsigned long long>( sim->event_mgr.max_events_remaining ),
 #ifdef EVENT_QUEUE_DEBUG
       sim->event_mgr.n_allocated_events, sim->event_mgr.n_end_insert,
       100.0 * static_cast<double>( sim->event_mgr.n_end_insert ) /
@@ -794,6 +795,7 @@ void print_text_performance( FILE* file, sim_t* sim )
       sim->event_mgr.max_queue_depth,
       static_cast<double>( sim->event_mgr.events_traversed ) /
           sim->event_mgr.events_added,
+      sim->event_mgr.n_unlinked_events,
 #endif
       sim->target->resources.base[ RESOURCE_HEALTH ],
       sim->iterations * sim->simulation_length.mean(), sim->elapsed_cpu,
@@ -1093,6 +1095,33 @@ void print_text_reference_dps( FILE* file, sim_t* sim )
   }
 }
 
+#ifdef CALLBACK_STATS
+// print_text_callbacks =====================================================
+
+void print_text_callbacks( FILE* file, sim_t* sim )
+{
+  bool header = false;
+
+  for ( const auto& player : sim->player_list.data() )
+  {
+    const auto& cb = player->callbacks;
+    if ( cb.n_evaluated == 0 )
+      continue;
+
+    if ( !header )
+    {
+      util::fprintf( file, "\nProc Callbacks (evaluated / triggered):\n" );
+      header = true;
+    }
+
+    util::fprintf( file, "%12llu / %12llu (%5.2f%%) : %s\n",
+                   static_cast<unsigned long long>( cb.n_evaluated ),
+                   static_cast<unsigned long long>( cb.n_triggered ),
+                   100.0 * cb.n_triggered / cb.n_evaluated, player->name() );
+  }
+}
+#endif /* CALLBACK_STATS */
+
 struct sort_by_event_stopwatch
 {
   bool operator()( player_t* l, player_t* r )
@@ -1160,6 +1189,21 @@ void print_text_player( FILE* file, player_t* p )
           : 0,
       p->dps_convergence * 100 );
 
+  double cv_mean, cv_error;
+  if ( p->sim->control_variates &&
+       cd.control_variate_estimate( *p->sim, cv_mean, cv_error ) )
+  {
+    const std::vector<double>& data = cd.target_metric.data();
+    double mean = statistics::calculate_mean( data );
+    double error = p->sim->confidence_estimator *
+                   statistics::calculate_mean_stddev( data );
+    util::fprintf( file,
+                   "  Target-Metric: %.1f  Error=%.1f/%.3f%%  "
+                   "Control-Variate-Adjusted: %.1f  Error=%.1f/%.3f%%\n",
+                   mean, error, mean ? error * 100 / mean : 0, cv_mean,
+                   cv_error, cv_mean ? cv_error * 100 / cv_mean : 0 );
+  }
+
   double hps_error =
       sim_t::distribution_mean_error( *p->sim, p->collected_data.hps );
   util::fprintf( file, "  HPS: %.1f HPS-Error=%.1f/%.1f%%\n", cd.hps.mean(),
@@ -1348,6 +1392,9 @@ void print_text_report( FILE* file, sim_t* sim, bool detail )
     print_text_iteration_data( file, sim );
     print_text_scale_factors( file, sim );
     print_text_reference_dps( file, sim );
+#ifdef CALLBACK_STATS
+    print_text_callbacks( file, sim );
+#endif
     print_text_monitor_cpu( file, sim );
   }
 
@@ -5,6 +5,8 @@
 
 #include "simulationcraft.hpp"
 #include "sim/sc_profileset.hpp"
+#include "sim/sc_job.hpp"
+#include "sim/sc_result_file.hpp"
 #include <locale>
 
 #ifdef SC_SIGACTION
@@ -58,6 +60,12 @@ struct sim_signal_handler_t
         global_sim -> interrupt();
       }
     }
+    // Without a simulator to interrupt (e.g., simulation service), fall back to default handling
+    else
+    {
+      std::signal( signal, SIG_DFL );
+      std::raise( signal );
+    }
   }
 
   static void sigsegv( int signal )
@@ -213,6 +221,14 @@ int sim_t::main( const std::vector<std::string>& args )
   // begins
   hotfix::apply();
 
+  // Simulation service, runs any number of independent simulators on top of the global state
+  // initialized above
+  if ( job::service_requested( control.options ) )
+  {
+    sim_signal_handler_t::global_sim = nullptr;
+    return job::main( control.options );
+  }
+
   bool setup_success = true;
   std::string errmsg;
   try
@@ -273,6 +289,19 @@ int sim_t::main( const std::vector<std::string>& args )
     std::cout << "\nGenerating profiles... \n";
     report::print_profiles( this );
   }
+  else if ( ! load_results_file_str.empty() )
+  {
+    util::printf( "\nLoading results from '%s' ...\n\n", load_results_file_str.c_str() );
+
+    if ( result_file_t::load( *this ) )
+    {
+      report::print_suite( this );
+    }
+    else
+    {
+      canceled = 1;
+    }
+  }
   else
   {
     util::printf( "\nSimulating... ( iterations=%d, threads=%d, target_error=%.3f,  max_time=%.0f, vary_combat_length=%0.2f, optimal_raid=%d, fight_style=%s )\n\n",
@@ -291,6 +320,11 @@ int sim_t::main( const std::vector<std::string>& args )
       }
       else
       {
+        if ( result_file )
+        {
+          result_file -> save();
+        }
+
         report::print_suite( this );
       }
     }
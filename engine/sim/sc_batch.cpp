@@ -0,0 +1,257 @@
+// ==========================================================================
+// Dedmonwakeen's Raid DPS/TPS Simulator.
+// Send questions to natehieter@gmail.com
+// ==========================================================================
+
+// Batch mode
+//
+// Runs any number of independent simulation inputs in a single process (batch=<path>, repeatable).
+// The path is either a .simc file, or a directory whose .simc files are all simulated. A single file
+// may contain multiple documents, separated by lines consisting only of "---". Each document is
+// parsed on top of the remaining command line options, and simulated as its own job. Unless the
+// document defines its own reports, a text (<name>.txt) and a JSON v2 (<name>.json) report is written
+// into batch_output=<dir> (default current directory) for each document.
+
+#include "simulationcraft.hpp"
+#include "sc_job.hpp"
+
+#include <unordered_set>
+
+namespace job
+{
+namespace batch
+{
+namespace
+{
+struct input_t
+{
+  std::string name;
+  std::string path;
+  std::string text;
+};
+
+bool is_separator( const std::string& line )
+{
+  auto first = line.find_first_not_of( " \t\r" );
+  auto last = line.find_last_not_of( " \t\r" );
+
+  return first != std::string::npos && line.compare( first, last - first + 1, "---" ) == 0;
+}
+
+std::string stem( const std::string& path )
+{
+  auto base_it = path.find_last_of( "/\\" );
+  std::string file_name = base_it != std::string::npos ? path.substr( base_it + 1 ) : path;
+
+  auto ext_it = file_name.rfind( '.' );
+  if ( ext_it != std::string::npos && ext_it > 0 )
+  {
+    file_name.erase( ext_it );
+  }
+
+  return file_name;
+}
+
+std::string directory( const std::string& path )
+{
+  auto base_it = path.find_last_of( "/\\" );
+  return base_it != std::string::npos ? path.substr( 0, base_it ) : std::string( "." );
+}
+
+bool has_extension( const std::string& file_name, const std::string& ext )
+{
+  return file_name.size() > ext.size() &&
+         util::str_compare_ci( file_name.substr( file_name.size() - ext.size() ), ext );
+}
+
+// Split an input file into its documents
+void read_input( const std::string& path, std::vector<input_t>& inputs )
+{
+  io::cfile file( path, "r" );
+  if ( ! file )
+  {
+    std::stringstream s;
+    s << "Unable to open batch input '" << path << "'";
+    throw std::invalid_argument( s.str() );
+  }
+
+  std::vector<std::string> documents( 1 );
+  auto lines = util::string_split( io::read_file_content( file ), "\n" );
+  for ( const auto& line : lines )
+  {
+    if ( is_separator( line ) )
+    {
+      documents.push_back( std::string() );
+    }
+    else
+    {
+      documents.back() += line;
+      documents.back() += '\n';
+    }
+  }
+
+  // Separators at the start or the end of the file do not introduce documents
+  documents.erase( std::remove_if( documents.begin(), documents.end(), []( const std::string& doc ) {
+    return doc.find_first_not_of( " \t\r\n" ) == std::string::npos;
+  } ), documents.end() );
+
+  for ( size_t i = 0; i < documents.size(); ++i )
+  {
+    std::string name = stem( path );
+    if ( documents.size() > 1 )
+    {
+      name += "_" + util::to_string( i + 1 );
+    }
+
+    inputs.push_back( { name, path, documents[ i ] } );
+  }
+}
+
+// Expand the batch paths into a list of documents to simulate, directories are expanded to their
+// .simc files in name order
+std::vector<input_t> collect_inputs( const std::vector<std::string>& paths )
+{
+  std::vector<input_t> inputs;
+
+  for ( const auto& path : paths )
+  {
+    std::vector<std::string> files;
+    if ( io::list_directory( path, files ) )
+    {
+      range::sort( files );
+      for ( const auto& file : files )
+      {
+        if ( has_extension( file, ".simc" ) )
+        {
+          read_input( path + "/" + file, inputs );
+        }
+      }
+    }
+    else
+    {
+      read_input( path, inputs );
+    }
+  }
+
+  // Job names are used for report file names, and have to be unique. A renamed input may collide
+  // with the name of another input (e.g., x.simc, x.simc, x_2.simc), so every candidate is checked
+  // against all names given out so far.
+  std::unordered_set<std::string> names;
+  for ( auto& input : inputs )
+  {
+    std::string name = input.name;
+    for ( unsigned n = 2; ! names.insert( name ).second; ++n )
+    {
+      name = input.name + "_" + util::to_string( n );
+    }
+    input.name = name;
+  }
+
+  return inputs;
+}
+
+bool defines_option( const option_db_t& options, const std::vector<std::string>& names )
+{
+  return range::find_if( options, [ &names ]( const option_tuple_t& opt ) {
+    return range::find_if( names, [ &opt ]( const std::string& name ) {
+      return util::str_compare_ci( opt.name, name );
+    } ) != names.end();
+  } ) != options.end();
+}
+} // unnamed namespace
+
+// run ======================================================================
+
+int run( const std::vector<std::string>& paths, const std::string& output_dir, const option_db_t& base,
+         const budget_t& budget )
+{
+  std::vector<input_t> inputs;
+  try
+  {
+    inputs = collect_inputs( paths );
+  }
+  catch ( const std::exception& e )
+  {
+    std::cerr << "ERROR! " << e.what() << std::endl;
+    return 1;
+  }
+
+  if ( inputs.empty() )
+  {
+    std::cerr << "ERROR! No batch inputs found" << std::endl;
+    return 1;
+  }
+
+  std::cerr << "Simulating " << inputs.size() << " batch inputs (" << budget.jobs << " simultaneous jobs, "
+            << budget.sim_threads << " threads per job)" << std::endl;
+
+  std::mutex output_mutex;
+  size_t n_failed = 0;
+
+  pool_t pool( budget.jobs, budget.sim_threads );
+
+  for ( const auto& input : inputs )
+  {
+    option_db_t options( base );
+    // Relative input= paths inside the document are resolved against the document first
+    options.auto_path.insert( options.auto_path.begin(), directory( input.path ) );
+    options.var_map[ "current_base_name" ] = input.name;
+
+    try
+    {
+      options.parse_text( input.text );
+    }
+    catch ( const std::exception& e )
+    {
+      std::lock_guard<std::mutex> lock( output_mutex );
+      std::cerr << input.name << ": failed: " << e.what() << std::endl;
+      ++n_failed;
+      continue;
+    }
+
+    // Simultaneous jobs must not share the standard output, and each input gets its own report
+    auto prefix = output_dir + "/" + input.name;
+    if ( ! defines_option( options, { "output" } ) )
+    {
+      options.add( "global", "output", prefix + ".txt" );
+    }
+
+    if ( ! defines_option( options, { "html", "xml", "json", "json2" } ) )
+    {
+      options.add( "global", "json2", prefix + ".json" );
+    }
+
+    auto job = std::make_shared<job_t>( input.name, options, REPORT_FILES );
+    job -> on_finish = [ &output_mutex, &n_failed ]( job_t& j ) {
+      std::lock_guard<std::mutex> lock( output_mutex );
+      std::cerr << j.name() << ": " << job_state_string( j.state() );
+      if ( j.state() != JOB_DONE )
+      {
+        std::cerr << ": " << j.result();
+        ++n_failed;
+      }
+      std::cerr << std::endl;
+    };
+
+    try
+    {
+      pool.submit( job );
+    }
+    catch ( const std::exception& e )
+    {
+      std::lock_guard<std::mutex> lock( output_mutex );
+      std::cerr << input.name << ": failed: " << e.what() << std::endl;
+      ++n_failed;
+    }
+  }
+
+  pool.wait();
+
+  std::cerr << "Batch finished, " << ( inputs.size() - n_failed ) << " of " << inputs.size()
+            << " inputs simulated successfully" << std::endl;
+
+  return n_failed > 0;
+}
+
+} // Namespace batch ends
+} // Namespace job ends
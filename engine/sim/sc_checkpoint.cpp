@@ -0,0 +1,307 @@
+// ==========================================================================
+// Dedmonwakeen's Raid DPS/TPS Simulator.
+// Send questions to natehieter@gmail.com
+// ==========================================================================
+
+#include "simulationcraft.hpp"
+#include "sc_checkpoint.hpp"
+
+namespace
+{
+const uint32_t CHECKPOINT_MAGIC   = 0x4b434353; // "SCCK"
+const uint32_t CHECKPOINT_VERSION = 6;
+
+struct header_t
+{
+  uint64_t fingerprint;
+  int thread_index;
+  uint64_t work_done;
+  std::string rng_state;
+};
+
+std::string thread_path( const sim_t& sim, int thread_index )
+{
+  if ( thread_index == 0 )
+  {
+    return sim.checkpoint_file_str;
+  }
+
+  return sim.checkpoint_file_str + "." + util::to_string( thread_index );
+}
+
+// FNV-1a hash of the simulation options, a checkpoint can only be resumed by the same simulation
+uint64_t fingerprint( const sim_t& sim )
+{
+  uint64_t hash = 14695981039346656037ULL;
+  auto add = [ &hash ]( const std::string& str ) {
+    for ( unsigned char c : str )
+    {
+      hash ^= c;
+      hash *= 1099511628211ULL;
+    }
+    // Separate consecutive strings
+    hash ^= 0xff;
+    hash *= 1099511628211ULL;
+  };
+
+  for ( const auto& opt : sim.control -> options )
+  {
+    if ( util::str_prefix_ci( opt.name, "checkpoint" ) )
+    {
+      continue;
+    }
+
+    add( opt.scope );
+    add( opt.name );
+    add( opt.value );
+  }
+
+  // The number of threads may depend on the system running the simulation
+  add( util::to_string( sim.threads ) );
+
+  return hash;
+}
+
+// Read a checkpoint file, returns nullptr if the file does not exist
+std::unique_ptr<archive_t> read_checkpoint( const std::string& path, uint64_t fingerprint, int thread_index,
+                                            header_t& header )
+{
+  io::cfile file( path, "rb" );
+  if ( ! file )
+  {
+    return std::unique_ptr<archive_t>();
+  }
+
+  std::string data;
+  std::array<char, 65536> buffer;
+  size_t n;
+  while ( ( n = fread( buffer.data(), 1, buffer.size(), file ) ) > 0 )
+  {
+    data.append( buffer.data(), n );
+  }
+
+  std::unique_ptr<archive_t> ar( new archive_t( data ) );
+  if ( data.size() < 2 * sizeof( uint32_t ) || ar -> read<uint32_t>() != CHECKPOINT_MAGIC ||
+       ar -> read<uint32_t>() != CHECKPOINT_VERSION )
+  {
+    throw std::runtime_error( "'" + path + "' is not a checkpoint of this version of the simulator" );
+  }
+
+  header.fingerprint = ar -> read<uint64_t>();
+  header.thread_index = ar -> read<int>();
+  header.work_done = ar -> read<uint64_t>();
+  ar -> read( header.rng_state );
+
+  if ( header.fingerprint != fingerprint || header.thread_index != thread_index )
+  {
+    throw std::runtime_error( "Checkpoint '" + path + "' was saved by a different simulation" );
+  }
+
+  return ar;
+}
+
+// Replace the checkpoint file, an interrupted write never destroys the previous checkpoint
+bool write_checkpoint( const std::string& path, const std::string& data )
+{
+  std::string tmp_path = path + ".tmp";
+
+  {
+    io::cfile file( tmp_path, "wb" );
+    if ( ! file || fwrite( data.data(), 1, data.size(), file ) != data.size() )
+    {
+      return false;
+    }
+  }
+
+  if ( std::rename( tmp_path.c_str(), path.c_str() ) != 0 )
+  {
+    // Renaming over an existing file fails on some platforms
+    std::remove( path.c_str() );
+    return std::rename( tmp_path.c_str(), path.c_str() ) == 0;
+  }
+
+  return true;
+}
+
+// Checkpoint errors cancel the whole simulation, not just the failing thread
+void fail( sim_t& sim, const std::string& error )
+{
+  sim_t& root = sim.thread_index == 0 ? sim : *sim.parent;
+
+  root.errorf( "%s", error.c_str() );
+  root.cancel();
+}
+
+// Threads either have their own work queue, or share the queue of the main thread
+bool shared_work_queue( const sim_t& sim )
+{
+  if ( sim.thread_index > 0 )
+  {
+    return sim.work_queue == sim.parent -> work_queue;
+  }
+
+  return ! sim.children.empty() && sim.children.front() -> work_queue == sim.work_queue;
+}
+} // unnamed namespace
+
+// checkpoint_t::checkpoint_t ===============================================
+
+checkpoint_t::checkpoint_t( sim_t& sim ) :
+  m_sim( sim ),
+  m_path( thread_path( sim, sim.thread_index ) ),
+  m_fingerprint( fingerprint( sim ) ),
+  m_last_save( util::wall_time() ),
+  m_sim_pos( 0 )
+{ }
+
+// checkpoint_t::enabled ====================================================
+
+bool checkpoint_t::enabled( const sim_t& sim )
+{
+  if ( sim.checkpoint_file_str.empty() )
+  {
+    return false;
+  }
+
+  // The main simulation, or one of its threads
+  return ! sim.parent || ( sim.thread_index > 0 && ! sim.parent -> parent );
+}
+
+// checkpoint_t::work_done ==================================================
+
+size_t checkpoint_t::work_done( sim_t& sim )
+{
+  uint64_t fp = fingerprint( sim );
+  size_t total = 0;
+
+  try
+  {
+    for ( int i = 0; i < sim.threads; ++i )
+    {
+      header_t header;
+      if ( read_checkpoint( thread_path( sim, i ), fp, i, header ) )
+      {
+        total += static_cast<size_t>( header.work_done );
+      }
+    }
+  }
+  catch ( const std::exception& e )
+  {
+    fail( sim, std::string( "Unable to resume from checkpoint: " ) + e.what() );
+    return 0;
+  }
+
+  return total;
+}
+
+// checkpoint_t::resume =====================================================
+
+bool checkpoint_t::resume()
+{
+  if ( ! m_sim.checkpoint_resume )
+  {
+    return false;
+  }
+
+  try
+  {
+    header_t header;
+    m_resume = read_checkpoint( m_path, m_fingerprint, m_sim.thread_index, header );
+    if ( ! m_resume )
+    {
+      return false;
+    }
+
+    m_sim_pos = m_resume -> position();
+    m_resume -> object( m_sim );
+
+    m_sim.rng().restore( header.rng_state );
+
+    // Work of a shared queue is advanced for all threads at once, when the threads are created
+    if ( ! shared_work_queue( m_sim ) )
+    {
+      m_sim.work_queue -> advance( as<int>( header.work_done ) );
+    }
+  }
+  catch ( const std::exception& e )
+  {
+    m_resume.reset();
+    fail( m_sim, std::string( "Unable to resume from checkpoint: " ) + e.what() );
+    return false;
+  }
+
+  if ( m_sim.thread_index == 0 )
+  {
+    std::cout << "Resuming simulation from checkpoint '" << m_path << "' after " << m_sim.work_done
+              << " iterations ..." << std::endl;
+  }
+
+  return true;
+}
+
+// checkpoint_t::load =======================================================
+
+// Load the checkpoint data of objects created after the simulation resumed (e.g., on first use in
+// an iteration). Each object is loaded exactly once.
+void checkpoint_t::load()
+{
+  m_resume -> rewind( m_sim_pos );
+  m_resume -> object( m_sim );
+}
+
+// checkpoint_t::save =======================================================
+
+void checkpoint_t::save()
+{
+  try
+  {
+    if ( m_resume )
+    {
+      load();
+    }
+  }
+  catch ( const std::exception& e )
+  {
+    fail( m_sim, std::string( "Unable to resume from checkpoint: " ) + e.what() );
+    return;
+  }
+
+  archive_t ar;
+  ar.write( CHECKPOINT_MAGIC );
+  ar.write( CHECKPOINT_VERSION );
+  ar.write( m_fingerprint );
+  ar.write( m_sim.thread_index );
+  ar.write( static_cast<uint64_t>( m_sim.work_done ) );
+  ar.write( m_sim.rng().state() );
+  ar.object( m_sim );
+
+  if ( ! write_checkpoint( m_path, ar.data() ) )
+  {
+    m_sim.errorf( "Unable to write checkpoint '%s'", m_path.c_str() );
+  }
+
+  m_last_save = util::wall_time();
+}
+
+// checkpoint_t::update =====================================================
+
+void checkpoint_t::update()
+{
+  if ( m_sim.work_done > 0 && util::wall_time() - m_last_save >= m_sim.checkpoint_interval )
+  {
+    save();
+  }
+}
+
+// checkpoint_t::finish =====================================================
+
+void checkpoint_t::finish()
+{
+  // Iterations of canceled simulations may be incomplete
+  if ( m_sim.canceled )
+  {
+    return;
+  }
+
+  save();
+}
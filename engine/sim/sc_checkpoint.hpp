@@ -0,0 +1,64 @@
+// ==========================================================================
+// Dedmonwakeen's Raid DPS/TPS Simulator.
+// Send questions to natehieter@gmail.com
+// ==========================================================================
+#ifndef SC_CHECKPOINT_HH
+#define SC_CHECKPOINT_HH
+
+#include <cstdint>
+#include <memory>
+#include <string>
+
+#include "util/generic.hpp"
+#include "util/archive.hpp"
+
+struct sim_t;
+
+// Simulation checkpoints ===================================================
+//
+// Periodically saves the collected data of a simulator thread (checkpoint=<file>, every
+// checkpoint_interval=<seconds>), along with everything needed to continue the simulation from
+// the same point: iteration counts, work queue progress and random number generator state. Each
+// simulator thread writes its own file (<file> for the main thread, <file>.<thread_index> for the
+// others). With checkpoint_resume=1, the threads continue from their checkpoints, which gives the
+// same results as an uninterrupted run for deterministic simulations.
+//
+// Checkpointing covers the main simulation. Scaling, plotting and profileset simulations are not
+// checkpointed.
+
+struct checkpoint_t : private noncopyable
+{
+private:
+  sim_t& m_sim;
+  std::string m_path;
+  uint64_t m_fingerprint;
+  double m_last_save;
+  // Checkpoint data of a resumed simulation, and the start of the serialized simulator in it
+  std::unique_ptr<archive_t> m_resume;
+  size_t m_sim_pos;
+
+  void load();
+  void save();
+
+public:
+  checkpoint_t( sim_t& sim );
+
+  // True, if the simulator participates in checkpointing
+  static bool enabled( const sim_t& sim );
+
+  // Number of iterations done by all threads of a resumed simulation. Used to advance a work
+  // queue shared by all threads.
+  static size_t work_done( sim_t& sim );
+
+  // Continue from the checkpoint, called once the simulator is initialized. Returns true if the
+  // simulation was resumed.
+  bool resume();
+
+  // Save the checkpoint if the checkpoint interval elapsed, called between iterations
+  void update();
+
+  // Final checkpoint at the end of the simulation
+  void finish();
+};
+
+#endif // SC_CHECKPOINT_HH
@@ -12,6 +12,7 @@
 event_t::event_t( sim_t& s, actor_t* a )
   : _sim( s ),
     next( nullptr ),
+    prev_next( nullptr ),
     time( timespan_t::zero() ),
     reschedule_time( timespan_t::zero() ),
     id( 0 ),
@@ -76,7 +77,14 @@ void event_t::cancel( event_t*& e )
 #endif
 
   e->canceled = true;
-  e           = nullptr;
+
+  // The currently executing event is not in the timing wheel, and is recycled once it finishes
+  if ( e->_sim.event_mgr.unlink_canceled && e->prev_next )
+  {
+    e->_sim.event_mgr.unlink_event( e );
+  }
+
+  e = nullptr;
 }
 
 // ==========================================================================
@@ -103,17 +111,18 @@ event_manager_t::event_manager_t( sim_t* s )
     wheel_granularity( 0.0 ),
     wheel_time( timespan_t::zero() ),
     event_stopwatch( STOPWATCH_THREAD ),
-#ifdef EVENT_QUEUE_DEBUG
     monitor_cpu( false ),
+    canceled( false ),
+    unlink_canceled( false )
+#ifdef EVENT_QUEUE_DEBUG
+    ,
     max_queue_depth( 0 ),
     n_allocated_events( 0 ),
-    n_requested_events( 0 ),
     n_end_insert( 0 ),
+    n_requested_events( 0 ),
+    n_unlinked_events( 0 ),
     events_traversed( 0 ),
     events_added( 0 )
-#else
-    monitor_cpu( false ),
-    canceled( false )
 #endif /* EVENT_QUEUE_DEBUG */
 {
   allocated_events.reserve( 100 );
@@ -244,8 +253,13 @@ void event_manager_t::add_event( event_t* e, timespan_t delta_time )
   }
 #endif
   // insert event
-  e->next = *prev;
-  *prev   = e;
+  e->next      = *prev;
+  e->prev_next = prev;
+  if ( e->next )
+  {
+    e->next->prev_next = &( e->next );
+  }
+  *prev = e;
 
   if ( ++events_remaining > max_events_remaining )
     max_events_remaining = events_remaining;
@@ -265,6 +279,74 @@ void event_manager_t::add_event( event_t* e, timespan_t delta_time )
 #endif
 }
 
+// event_manager_t::insert_event ============================================
+
+// Inserts an event that already has its time and id, behind the events of the same time with a
+// lower id. The event keeps the place in the execution order its id gives it.
+void event_manager_t::insert_event( event_t* e )
+{
+  assert( e -> next == nullptr );
+  assert( e -> time >= current_time && e -> time - current_time <= wheel_time );
+
+  uint32_t slice = static_cast<uint32_t>(
+      ( e->time.total_millis() >> wheel_shift ) & wheel_mask );
+
+  event_t** prev = &( timing_wheel[ slice ] );
+  while ( ( *prev ) && ( ( *prev )->time < e->time ||
+                         ( ( *prev )->time == e->time && ( *prev )->id < e->id ) ) )
+  {
+    prev = &( ( *prev )->next );
+  }
+
+  e->next      = *prev;
+  e->prev_next = prev;
+  if ( e->next )
+  {
+    e->next->prev_next = &( e->next );
+  }
+  *prev = e;
+
+  if ( ++events_remaining > max_events_remaining )
+    max_events_remaining = events_remaining;
+
+  if ( sim->debug )
+    sim->out_debug.printf( "Insert Event: %s time=%.4f id=%d",
+                           e->name(), e->time.total_seconds(), e->id );
+
+#if ACTOR_EVENT_BOOKKEEPING
+  if ( sim->debug && e->actor )
+  {
+    e->actor->event_counter++;
+  }
+#endif
+}
+
+// event_manager_t::unlink_event ============================================
+
+void event_manager_t::unlink_event( event_t* e )
+{
+  assert( e->prev_next && *( e->prev_next ) == e );
+
+  *( e->prev_next ) = e->next;
+  if ( e->next )
+  {
+    e->next->prev_next = e->prev_next;
+  }
+
+  e->next      = nullptr;
+  e->prev_next = nullptr;
+  events_remaining--;
+
+#ifdef EVENT_QUEUE_DEBUG
+  n_unlinked_events++;
+#endif
+
+  if ( sim->debug )
+    sim->out_debug.printf( "Unlink Event: %s %d", e->name(), e->id );
+
+  recycle_event( e );
+}
+
 // event_manager_t::reschedule_event ========================================
 
 void event_manager_t::reschedule_event( event_t* e )
@@ -367,6 +449,7 @@ void event_manager_t::flush()
   {
     if ( e->recycled )
       continue;
+    e->prev_next = nullptr; // The timing wheel is cleared below
     event_t* null_e = e;  // necessary evil
     event_t::cancel( null_e );
     recycle_event( e );
@@ -421,6 +504,12 @@ event_t* event_manager_t::next_event()
     {
       event_t* e = event_list;
       event_list = e->next;
+      if ( event_list )
+      {
+        event_list->prev_next = &event_list;
+      }
+      e->next      = nullptr;
+      e->prev_next = nullptr;
       events_remaining--;
       events_processed++;
       return e;
@@ -462,6 +551,7 @@ void event_manager_t::merge( event_manager_t& other )
   n_allocated_events += other.n_allocated_events;
   n_end_insert += other.n_end_insert;
   n_requested_events += other.n_requested_events;
+  n_unlinked_events += other.n_unlinked_events;
   if ( other.max_queue_depth > max_queue_depth )
   {
     max_queue_depth = other.max_queue_depth;
@@ -487,3 +577,11 @@ void event_manager_t::merge( event_manager_t& other )
 
 #endif
 }
+
+// event_manager_t::serialize ===============================================
+
+void event_manager_t::serialize( archive_t& ar )
+{
+  ar.maximum( max_events_remaining );
+  ar.add( total_events_processed );
+}
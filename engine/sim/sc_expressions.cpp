@@ -6,6 +6,10 @@
 #include "sc_expressions.hpp"
 #include "simulationcraft.hpp"
 
+#include <list>
+#include <memory>
+#include <unordered_map>
+
 namespace expression
 {
 
@@ -36,6 +40,24 @@ public:
   {
     return F()( input->eval() );
   }
+
+  expr_t* fold() override  // override
+  {
+    input = input->fold();
+    double input_value;
+    if ( !input->is_constant( &input_value ) )
+      return this;
+
+    expr_t* folded = new const_expr_t(
+        std::string( "const_unary('" ) + input->name() + "')", evaluate() );
+    delete this;
+    return folded;
+  }
+
+  int node_count() override  // override
+  {
+    return 1 + input->node_count();
+  }
 };
 
 namespace unary
@@ -108,6 +130,60 @@ expr_t* select_unary( const std::string& name, token_e op, expr_t* input )
   }
 }
 
+// Constant Folding =========================================================
+
+// Fold a binary operator of already folded operands. Returns the folded
+// expression, or the operator itself if it cannot be folded. Operands that are
+// not part of the folded expression are deleted.
+expr_t* fold_binary( expr_t* expr, expr_t* left, expr_t* right )
+{
+  double left_value, right_value;
+  bool left_constant  = left->is_constant( &left_value );
+  bool right_constant = right->is_constant( &right_value );
+
+  if ( left_constant && right_constant )
+  {
+    expr_t* folded = new const_expr_t( std::string( "const_binary('" ) +
+                                           left->name() + "','" +
+                                           right->name() + "')",
+                                       expr->evaluate() );
+    delete left;
+    delete right;
+    return folded;
+  }
+
+  if ( !left_constant && !right_constant )
+    return expr;
+
+  // Logical operators with one constant operand reduce to a constant, or to
+  // (the negation of) the other operand
+  bool constant_true = left_constant ? left_value != 0 : right_value != 0;
+  expr_t* constant   = left_constant ? left : right;
+  expr_t* other      = left_constant ? right : left;
+  switch ( expr->op_ )
+  {
+    case TOK_AND:
+      delete constant;
+      if ( constant_true )
+        return other;
+      delete other;
+      return new const_expr_t( "const_and", 0.0 );
+    case TOK_OR:
+      delete constant;
+      if ( !constant_true )
+        return other;
+      delete other;
+      return new const_expr_t( "const_or", 1.0 );
+    case TOK_XOR:
+      delete constant;
+      if ( !constant_true )
+        return other;
+      return select_unary( "not_xor", TOK_NOT, other );
+    default:
+      return expr;
+  }
+}
+
 // Binary Operators =========================================================
 
 class binary_base_t : public expr_t
@@ -128,6 +204,25 @@ public:
     delete left;
     delete right;
   }
+
+  expr_t* fold() override  // override
+  {
+    left           = left->fold();
+    right          = right->fold();
+    expr_t* folded = fold_binary( this, left, right );
+    if ( folded != this )
+    {
+      // The operands are deleted, or owned by the folded expression
+      left = right = nullptr;
+      delete this;
+    }
+    return folded;
+  }
+
+  int node_count() override  // override
+  {
+    return 1 + left->node_count() + right->node_count();
+  }
 };
 
 class logical_and_t : public binary_base_t
@@ -277,6 +372,26 @@ public:
     delete this;
     return expr;
   }
+
+  expr_t* fold() override  // override
+  {
+    input = input->fold();
+    double input_value;
+    if ( !input->is_constant( &input_value ) )
+      return this;
+
+    expr_t* folded = new const_expr_t(
+        std::string( "const_unary('" ) + input->name() + "')",
+        F()( input_value ) );
+    delete input;
+    delete this;
+    return folded;
+  }
+
+  int node_count() override  // override
+  {
+    return 1 + input->node_count();
+  }
 };
 
 expr_t* select_analyze_unary( const std::string& name, token_e op,
@@ -350,6 +465,21 @@ public:
   ~analyze_binary_base_t()
   {
   }
+
+  expr_t* fold() override  // override
+  {
+    left           = left->fold();
+    right          = right->fold();
+    expr_t* folded = fold_binary( this, left, right );
+    if ( folded != this )
+      delete this;
+    return folded;
+  }
+
+  int node_count() override  // override
+  {
+    return 1 + left->node_count() + right->node_count();
+  }
 };
 
 class analyze_logical_and_t : public analyze_binary_base_t
@@ -1085,7 +1215,8 @@ token_e next_token( action_t* action, const std::string& expr_str,
 // parse_tokens =============================================================
 
 std::vector<expr_token_t> parse_tokens( action_t* action,
-                                        const std::string& expr_str )
+                                        const std::string& expr_str,
+                                        bool* complete )
 {
   std::vector<expr_token_t> tokens;
 
@@ -1100,6 +1231,12 @@ std::vector<expr_token_t> parse_tokens( action_t* action,
     tokens.push_back( token );
   }
 
+  if ( complete )
+  {
+    // The terminating null character is consumed at the end of the string
+    *complete = current_index > as<int>( expr_str.size() );
+  }
+
   return tokens;
 }
 
@@ -1235,7 +1372,7 @@ int expr_t::get_global_id()
 // build_expression_tree ====================================================
 
 static expr_t* build_expression_tree(
-    action_t* action, std::vector<expression::expr_token_t>& tokens,
+    action_t* action, const std::vector<expression::expr_token_t>& tokens,
     bool optimize )
 {
   auto_dispose<std::vector<expr_t*>> stack;
@@ -1243,7 +1380,7 @@ static expr_t* build_expression_tree(
   size_t num_tokens = tokens.size();
   for ( size_t i = 0; i < num_tokens; i++ )
   {
-    expression::expr_token_t& t = tokens[ i ];
+    const expression::expr_token_t& t = tokens[ i ];
 
     if ( t.type == expression::TOK_NUM )
     {
@@ -1302,26 +1439,84 @@ static expr_t* build_expression_tree(
 
 // action_expr_t::create_constant ===========================================
 
-// action_expr_t::parse =====================================================
+// Expression programs ======================================================
 
-expr_t* expr_t::parse( action_t* action, const std::string& expr_str,
-                       bool optimize )
+// Expressions converted to RPN, shared by the actors and simulations initialized on the same
+// thread. Tokenization and RPN conversion only depend on the expression string, so actors using the
+// same action lists (e.g., consecutive profilesets) convert each expression once. Expression trees
+// are not cached: each action builds and optimizes its own tree from the cached program, because
+// the tree binds the buffs, cooldowns and resources of the actor. The cache is per thread, so that
+// parsing takes no lock, and holds the most recently used programs only, so that a long running
+// process (e.g., the simulation server) does not accumulate the expressions of every simulation it
+// has run.
+
+namespace
 {
-  if ( expr_str.empty() )
-    return nullptr;
+typedef std::vector<expression::expr_token_t> expr_program_t;
+
+const size_t MAX_CACHED_PROGRAMS = 4096;
+
+struct expr_program_cache_t
+{
+  typedef std::pair<std::string, std::shared_ptr<const expr_program_t>> entry_t;
+
+  // Most recently used first
+  std::list<entry_t> entries;
+  std::unordered_map<std::string, std::list<entry_t>::iterator> programs;
+
+  std::shared_ptr<const expr_program_t> find( const std::string& expr_str )
+  {
+    auto it = programs.find( expr_str );
+    if ( it == programs.end() )
+    {
+      return nullptr;
+    }
+
+    entries.splice( entries.begin(), entries, it->second );
+    return it->second->second;
+  }
+
+  void insert( const std::string& expr_str, const std::shared_ptr<const expr_program_t>& program )
+  {
+    if ( programs.find( expr_str ) != programs.end() )
+    {
+      return;
+    }
+
+    entries.emplace_front( expr_str, program );
+    programs[ expr_str ] = entries.begin();
+
+    if ( entries.size() > MAX_CACHED_PROGRAMS )
+    {
+      programs.erase( entries.back().first );
+      entries.pop_back();
+    }
+  }
+};
+
+expr_program_cache_t& expr_program_cache()
+{
+  thread_local expr_program_cache_t cache;
+  return cache;
+}
 
-  std::vector<expression::expr_token_t> tokens =
-      expression::parse_tokens( action, expr_str );
+// Tokenize and convert the expression to RPN, returns nullptr on error. complete is set to false if
+// the expression contains unexpected tokens.
+std::shared_ptr<const expr_program_t> compile_expression( action_t* action, const std::string& expr_str,
+                                                          bool& complete )
+{
+  std::shared_ptr<expr_program_t> tokens =
+      std::make_shared<expr_program_t>( expression::parse_tokens( action, expr_str, &complete ) );
 
   if ( action->sim->debug )
-    expression::print_tokens( tokens, action->sim );
+    expression::print_tokens( *tokens, action->sim );
 
-  expression::convert_to_unary( tokens );
+  expression::convert_to_unary( *tokens );
 
   if ( action->sim->debug )
-    expression::print_tokens( tokens, action->sim );
+    expression::print_tokens( *tokens, action->sim );
 
-  if ( !expression::convert_to_rpn( tokens ) )
+  if ( !expression::convert_to_rpn( *tokens ) )
   {
     action->sim->errorf( "%s-%s: Unable to convert %s into RPN\n",
                          action->player->name(), action->name(),
@@ -1331,9 +1526,53 @@ expr_t* expr_t::parse( action_t* action, const std::string& expr_str,
   }
 
   if ( action->sim->debug )
-    expression::print_tokens( tokens, action->sim );
+    expression::print_tokens( *tokens, action->sim );
+
+  return tokens;
+}
+
+// Cached program of the expression. Expressions with tokenization errors are not cached, so that
+// every actor using them reports the error. Debug simulations always convert the expression, to
+// log the tokens.
+std::shared_ptr<const expr_program_t> expression_program( action_t* action, const std::string& expr_str )
+{
+  bool complete = false;
+
+  if ( action->sim->debug )
+  {
+    return compile_expression( action, expr_str, complete );
+  }
+
+  expr_program_cache_t& cache = expr_program_cache();
+
+  if ( auto program = cache.find( expr_str ) )
+  {
+    return program;
+  }
+
+  std::shared_ptr<const expr_program_t> program = compile_expression( action, expr_str, complete );
+  if ( program && complete )
+  {
+    cache.insert( expr_str, program );
+  }
+
+  return program;
+}
+}  // unnamed namespace
+
+// action_expr_t::parse =====================================================
+
+expr_t* expr_t::parse( action_t* action, const std::string& expr_str,
+                       bool optimize )
+{
+  if ( expr_str.empty() )
+    return nullptr;
+
+  std::shared_ptr<const expr_program_t> program = expression_program( action, expr_str );
+  if ( !program )
+    return nullptr;
 
-  if ( expr_t* e = build_expression_tree( action, tokens, optimize ) )
+  if ( expr_t* e = build_expression_tree( action, *program, optimize ) )
     return e;
 
   action->sim->errorf( "%s-%s: Unable to build expression tree from %s\n",
@@ -64,8 +64,10 @@ bool is_binary( token_e );
 token_e next_token( action_t* action, const std::string& expr_str,
                     int& current_index, std::string& token_str,
                     token_e prev_token );
+// complete is set to true if the whole string was tokenized
 std::vector<expr_token_t> parse_tokens( action_t* action,
-                                        const std::string& expr_str );
+                                        const std::string& expr_str,
+                                        bool* complete = nullptr );
 void print_tokens( std::vector<expr_token_t>& tokens, sim_t* sim );
 void convert_to_unary( std::vector<expr_token_t>& tokens );
 bool convert_to_rpn( std::vector<expr_token_t>& tokens );
@@ -153,6 +155,21 @@ public:
     return false;
   }
 
+  // Fold the subexpressions that are constant for the whole simulation (e.g., talents, set bonuses)
+  // into constants, and return the folded expression. Unlike optimize(), subexpressions that are
+  // not constant are kept as is, so they can still be analyzed and optimized after the first
+  // iteration.
+  virtual expr_t* fold()
+  {
+    return this;
+  }
+
+  // Number of nodes in the expression tree
+  virtual int node_count()
+  {
+    return 1;
+  }
+
   expression::token_e op_;
 
 private:
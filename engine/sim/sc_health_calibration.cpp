@@ -0,0 +1,231 @@
+// ==========================================================================
+// Dedmonwakeen's Raid DPS/TPS Simulator.
+// Send questions to natehieter@gmail.com
+// ==========================================================================
+
+#include "simulationcraft.hpp"
+#include "sc_health_calibration.hpp"
+
+namespace
+{
+// Iterations simulated by each thread in a calibration round
+const int ROUND_ITERATIONS = 4;
+} // unnamed namespace
+
+// health_calibration_t::health_calibration_t ===============================
+
+health_calibration_t::health_calibration_t() :
+  m_calibrating( false ),
+  iterations( 0 )
+{ }
+
+// health_calibration_t::inherit ============================================
+
+void health_calibration_t::inherit( const health_calibration_t& parent )
+{
+  health = parent.health;
+  iterations = parent.iterations;
+}
+
+// health_calibration_t::enemy_health =======================================
+
+double health_calibration_t::enemy_health( const std::string& name ) const
+{
+  auto it = health.find( name );
+  return it != health.end() ? it -> second : 0;
+}
+
+// health_calibration_t::load ===============================================
+
+// One line per enemy: <name>,<health>
+bool health_calibration_t::load( const std::string& path )
+{
+  io::ifstream file;
+  file.open( path );
+  if ( ! file.is_open() )
+  {
+    return false;
+  }
+
+  std::unordered_map<std::string, double> loaded;
+  std::string line;
+  while ( std::getline( file, line ) )
+  {
+    auto pos = line.rfind( ',' );
+    if ( pos == std::string::npos || pos == 0 )
+    {
+      continue;
+    }
+
+    double h = util::from_string<double>( line.substr( pos + 1 ) );
+    if ( h > 0 )
+    {
+      loaded[ line.substr( 0, pos ) ] = h;
+    }
+  }
+
+  if ( loaded.empty() )
+  {
+    return false;
+  }
+
+  health = loaded;
+
+  return true;
+}
+
+// health_calibration_t::save ===============================================
+
+bool health_calibration_t::save( const std::string& path ) const
+{
+  io::ofstream file;
+  file.open( path );
+  if ( ! file.is_open() )
+  {
+    return false;
+  }
+
+  for ( const auto& entry : health )
+  {
+    file << entry.first << "," << util::to_string( entry.second, 0 ) << "\n";
+  }
+
+  return true;
+}
+
+// health_calibration_t::calibrate ==========================================
+
+void health_calibration_t::calibrate( sim_t& sim )
+{
+  health_calibration_t& hc = *sim.health_calibration;
+
+  if ( sim.enemy_health_calibration <= 0 || hc.m_calibrating || sim.thread_index > 0 ||
+       ! sim.overrides.target_health.empty() )
+  {
+    return;
+  }
+
+  // Scaling and plot simulations inherit the calibration of their parent, profilesets simulate
+  // different actors
+  if ( sim.parent && ! sim.profileset_enabled )
+  {
+    return;
+  }
+
+  hc.health.clear();
+  hc.iterations = 0;
+
+  if ( ! sim.parent && ! sim.enemy_health_calibration_load_str.empty() )
+  {
+    if ( hc.load( sim.enemy_health_calibration_load_str ) )
+    {
+      // A loaded calibration counts as a calibration of the full length
+      hc.iterations = sim.enemy_health_calibration * ROUND_ITERATIONS * std::max( sim.threads, 1 );
+      std::cout << "Loaded enemy health calibration from '" << sim.enemy_health_calibration_load_str
+                << "'" << std::endl;
+      return;
+    }
+
+    sim.errorf( "Unable to load enemy health calibration '%s', calibrating instead",
+                sim.enemy_health_calibration_load_str.c_str() );
+  }
+
+  int round = 0;
+  bool converged = false;
+  while ( round < sim.enemy_health_calibration && ! converged && ! sim.is_canceled() )
+  {
+    round++;
+
+    std::unique_ptr<sim_t> round_sim( new sim_t( &sim ) );
+    health_calibration_t& round_hc = *round_sim -> health_calibration;
+    round_hc.m_calibrating = true;
+
+    int round_iterations = ROUND_ITERATIONS * std::max( round_sim -> threads, 1 );
+    round_sim -> iterations = round_iterations;
+    round_sim -> work_queue -> init( round_iterations );
+    round_sim -> target_error = 0;
+    round_sim -> report_progress = 0;
+    round_sim -> progress_bar.set_base( "Health Calibration" );
+    round_sim -> execute();
+
+    if ( round_sim -> is_canceled() )
+    {
+      break;
+    }
+
+    // Average estimate of the threads, converged if no estimate changed more than the tolerance
+    std::unordered_map<std::string, double> estimate;
+    converged = true;
+    for ( const auto& entry : round_hc.m_estimates )
+    {
+      double sum = 0;
+      int n = 0;
+      for ( double h : entry.second )
+      {
+        if ( h > 0 )
+        {
+          sum += h;
+          n++;
+        }
+      }
+
+      if ( n == 0 )
+      {
+        continue;
+      }
+
+      double h = sum / n;
+      double previous = hc.enemy_health( entry.first );
+      if ( previous <= 0 || std::fabs( h - previous ) > previous * sim.enemy_health_calibration_tolerance / 100.0 )
+      {
+        converged = false;
+      }
+
+      estimate[ entry.first ] = h;
+    }
+
+    // Nothing to calibrate, e.g. enemies of fixed health
+    if ( estimate.empty() )
+    {
+      break;
+    }
+
+    hc.health = estimate;
+    hc.iterations += round_iterations;
+  }
+
+  if ( hc.health.empty() || sim.parent )
+  {
+    return;
+  }
+
+  std::cout << "Calibrated enemy health in " << round << " rounds (" << hc.iterations << " iterations)"
+            << ( converged ? "" : ", not converged" ) << std::endl;
+
+  if ( ! sim.enemy_health_calibration_save_str.empty() && ! hc.save( sim.enemy_health_calibration_save_str ) )
+  {
+    sim.errorf( "Unable to write enemy health calibration '%s'",
+                sim.enemy_health_calibration_save_str.c_str() );
+  }
+}
+
+// health_calibration_t::add_estimate =======================================
+
+void health_calibration_t::add_estimate( sim_t& sim, const std::string& name, double health )
+{
+  sim_t& root = sim.thread_index == 0 ? sim : *sim.parent;
+  health_calibration_t& hc = *root.health_calibration;
+
+  if ( ! hc.m_calibrating )
+  {
+    return;
+  }
+
+  AUTO_LOCK( hc.m_mutex );
+  auto& estimates = hc.m_estimates[ name ];
+  if ( estimates.size() <= as<size_t>( sim.thread_index ) )
+  {
+    estimates.resize( sim.thread_index + 1 );
+  }
+  estimates[ sim.thread_index ] = health;
+}
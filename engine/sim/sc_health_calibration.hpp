@@ -0,0 +1,70 @@
+// ==========================================================================
+// Dedmonwakeen's Raid DPS/TPS Simulator.
+// Send questions to natehieter@gmail.com
+// ==========================================================================
+#ifndef SC_HEALTH_CALIBRATION_HH
+#define SC_HEALTH_CALIBRATION_HH
+
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "util/generic.hpp"
+#include "util/concurrency.hpp"
+
+struct sim_t;
+
+// Enemy health calibration =================================================
+//
+// Health based fights estimate the health of the enemies over the first iterations of each
+// simulator thread. With enemy_health_calibration=<rounds>, the estimate is calibrated once before
+// the simulation instead: each round simulates a few iterations on every thread, starting from the
+// average estimate of the threads in the previous round, until the estimate changes less than
+// enemy_health_calibration_tolerance (percent) between rounds. The simulation, its threads, and its
+// scaling and plot simulations start from the calibrated health, and refine it with the dampening of
+// a simulation that already ran the calibration iterations. Profileset simulations simulate
+// different actors, and calibrate their own health.
+//
+// With enemy_health_calibration_save=<file>, the calibrated health is saved to the file. With
+// enemy_health_calibration_load=<file>, the health is loaded from the file instead of calibrating.
+// The file is not checked against the simulated actors, so it is up to the user to load only a
+// calibration of the same profiles and fight.
+
+struct health_calibration_t : private noncopyable
+{
+private:
+  // Health estimates of the threads of a calibration round, by enemy name
+  mutex_t m_mutex;
+  std::unordered_map<std::string, std::vector<double>> m_estimates;
+  bool m_calibrating;
+
+  bool load( const std::string& path );
+  bool save( const std::string& path ) const;
+
+public:
+  // Calibrated health of the enemies by name, empty if the health is not calibrated
+  std::unordered_map<std::string, double> health;
+  // Number of iterations behind the calibrated health
+  int iterations;
+
+  health_calibration_t();
+
+  // Inherit the calibrated health of the parent simulation
+  void inherit( const health_calibration_t& parent );
+
+  // True, if the simulation is a calibration round
+  bool calibrating() const
+  { return m_calibrating; }
+
+  // Calibrated health of the enemy, or 0 if the enemy health is not calibrated
+  double enemy_health( const std::string& name ) const;
+
+  // Calibrate the health of the enemies of the simulation, if enabled. Called before the
+  // simulation is initialized.
+  static void calibrate( sim_t& sim );
+
+  // Health estimate of an enemy at the end of an iteration of a calibration round
+  static void add_estimate( sim_t& sim, const std::string& name, double health );
+};
+
+#endif // SC_HEALTH_CALIBRATION_HH
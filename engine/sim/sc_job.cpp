@@ -0,0 +1,450 @@
+// ==========================================================================
+// Dedmonwakeen's Raid DPS/TPS Simulator.
+// Send questions to natehieter@gmail.com
+// ==========================================================================
+
+#include "simulationcraft.hpp"
+#include "sc_job.hpp"
+
+namespace job
+{
+namespace
+{
+// Options consumed by the service itself, every other option is a base option for the jobs
+bool is_service_option( const option_tuple_t& opt )
+{
+  static const std::vector<std::string> service_opts {
+    "server", "batch", "batch_output", "concurrent_jobs", "threads"
+  };
+
+  return range::find_if( service_opts, [ &opt ]( const std::string& name ) {
+    return util::str_compare_ci( opt.name, name );
+  } ) != service_opts.end();
+}
+
+std::string error_string( const sim_t& sim )
+{
+  std::string errors;
+
+  range::for_each( sim.error_list, [ &errors ]( const std::string& error ) {
+    if ( ! errors.empty() )
+    {
+      errors += '\n';
+    }
+    errors += error;
+  } );
+
+  return errors.empty() ? "Simulation failed" : errors;
+}
+} // unnamed namespace
+
+const char* job_state_string( job_state_e state )
+{
+  switch ( state )
+  {
+    case JOB_QUEUED:   return "queued";
+    case JOB_RUNNING:  return "running";
+    case JOB_DONE:     return "done";
+    case JOB_FAILED:   return "failed";
+    case JOB_CANCELED: return "canceled";
+    default:           return "unknown";
+  }
+}
+
+// job_t::job_t =============================================================
+
+job_t::job_t( const std::string& name, const option_db_t& options, job_report_e report ) :
+  m_name( name ), m_options( options ), m_report( report ), m_state( JOB_QUEUED ),
+  m_cancel( false ), m_sim( nullptr )
+{ }
+
+void job_t::finish( job_state_e state, const std::string& result )
+{
+  std::lock_guard<std::mutex> lock( m_mutex );
+
+  m_state = state;
+  m_result = result;
+}
+
+// job_t::run ===============================================================
+
+void job_t::run( int threads )
+{
+  {
+    std::lock_guard<std::mutex> lock( m_mutex );
+    if ( m_cancel )
+    {
+      m_state = JOB_CANCELED;
+      return;
+    }
+  }
+
+  sim_control_t control;
+  control.options = m_options;
+  // The thread count of each job is decided by the pool, override whatever the job defines
+  control.options.add( "global", "threads", util::to_string( threads ) );
+
+  std::unique_ptr<sim_t> sim( new sim_t() );
+  // Simultaneous jobs would garble each other's progress bars, and child threads must not be left
+  // hanging around in a long running process
+  sim -> report_progress = 0;
+  sim -> cleanup_threads = true;
+
+  {
+    std::lock_guard<std::mutex> lock( m_mutex );
+    m_state = JOB_RUNNING;
+    m_sim = sim.get();
+  }
+
+  job_state_e state = JOB_DONE;
+  std::string result;
+
+  try
+  {
+    auto process_opt = range::find_if( control.options, is_process_option );
+    if ( process_opt != control.options.end() )
+    {
+      throw std::invalid_argument( "Option '" + process_opt -> name +
+                                   "' changes process-wide data, and is not supported in simulation jobs" );
+    }
+
+    sim -> setup( &control );
+
+    if ( sim -> spell_query )
+    {
+      throw std::invalid_argument( "Spell queries are not supported in simulation jobs" );
+    }
+
+    if ( ! sim -> canceled && sim -> execute() )
+    {
+      sim -> scaling -> analyze();
+      sim -> plot -> analyze();
+      sim -> reforge_plot -> analyze();
+
+      if ( ! sim -> canceled && ! sim -> profilesets.iterate( sim.get() ) )
+      {
+        sim -> canceled = true;
+      }
+    }
+    else
+    {
+      sim -> canceled = true;
+    }
+
+    if ( sim -> canceled )
+    {
+      state = m_cancel ? JOB_CANCELED : JOB_FAILED;
+      result = m_cancel ? std::string() : error_string( *sim );
+    }
+    else if ( m_report == REPORT_JSON )
+    {
+      result = report::json2_string( *sim );
+    }
+    else
+    {
+      report::print_suite( sim.get() );
+    }
+  }
+  catch ( const std::exception& e )
+  {
+    state = m_cancel ? JOB_CANCELED : JOB_FAILED;
+    result = e.what();
+  }
+
+  {
+    std::lock_guard<std::mutex> lock( m_mutex );
+    m_sim = nullptr;
+  }
+
+  sim.reset();
+
+  finish( state, result );
+}
+
+// job_t::cancel ============================================================
+
+void job_t::cancel()
+{
+  std::lock_guard<std::mutex> lock( m_mutex );
+
+  m_cancel = true;
+  if ( m_sim )
+  {
+    m_sim -> cancel();
+  }
+}
+
+// pool_t::pool_t ===========================================================
+
+pool_t::pool_t( int n_jobs, int sim_threads ) :
+  m_sim_threads( sim_threads ), m_shutdown( false )
+{
+  for ( int i = 0; i < n_jobs; ++i )
+  {
+    m_workers.emplace_back( [ this ]() { worker(); } );
+  }
+}
+
+pool_t::~pool_t()
+{
+  shutdown();
+}
+
+// pool_t::worker ===========================================================
+
+void pool_t::worker()
+{
+  while ( true )
+  {
+    std::shared_ptr<job_t> job;
+
+    {
+      std::unique_lock<std::mutex> lock( m_mutex );
+      m_work.wait( lock, [ this ]() { return m_shutdown || ! m_queue.empty(); } );
+
+      // Queued work is always finished before the workers exit
+      if ( m_queue.empty() )
+      {
+        return;
+      }
+
+      job = m_queue.front();
+      m_queue.pop_front();
+      m_running.push_back( job );
+    }
+
+    job -> run( m_sim_threads );
+
+    {
+      std::lock_guard<std::mutex> lock( m_mutex );
+      m_running.erase( range::find( m_running, job ) );
+    }
+
+    // Report only after the job is no longer tracked, so that its name can be re-used immediately
+    if ( job -> on_finish )
+    {
+      job -> on_finish( *job );
+    }
+
+    m_idle.notify_all();
+  }
+}
+
+// pool_t::submit ===========================================================
+
+void pool_t::submit( const std::shared_ptr<job_t>& job )
+{
+  {
+    std::lock_guard<std::mutex> lock( m_mutex );
+
+    auto in_use = [ &job ]( const std::shared_ptr<job_t>& j ) { return j -> name() == job -> name(); };
+    if ( range::find_if( m_queue, in_use ) != m_queue.end() ||
+         range::find_if( m_running, in_use ) != m_running.end() )
+    {
+      std::stringstream s;
+      s << "Job '" << job -> name() << "' already exists";
+      throw std::invalid_argument( s.str() );
+    }
+
+    m_queue.push_back( job );
+  }
+
+  m_work.notify_one();
+}
+
+// pool_t::cancel ===========================================================
+
+bool pool_t::cancel( const std::string& name )
+{
+  std::shared_ptr<job_t> queued_job;
+
+  {
+    std::lock_guard<std::mutex> lock( m_mutex );
+
+    auto by_name = [ &name ]( const std::shared_ptr<job_t>& j ) { return j -> name() == name; };
+
+    auto running_it = range::find_if( m_running, by_name );
+    if ( running_it != m_running.end() )
+    {
+      ( *running_it ) -> cancel();
+      return true;
+    }
+
+    auto queue_it = range::find_if( m_queue, by_name );
+    if ( queue_it == m_queue.end() )
+    {
+      return false;
+    }
+
+    queued_job = *queue_it;
+    m_queue.erase( queue_it );
+  }
+
+  // A canceled job finishes immediately without ever creating a simulator
+  queued_job -> cancel();
+  queued_job -> run( m_sim_threads );
+  if ( queued_job -> on_finish )
+  {
+    queued_job -> on_finish( *queued_job );
+  }
+
+  m_idle.notify_all();
+
+  return true;
+}
+
+void pool_t::cancel()
+{
+  std::vector<std::string> names;
+
+  {
+    std::lock_guard<std::mutex> lock( m_mutex );
+    range::for_each( m_queue, [ &names ]( const std::shared_ptr<job_t>& j ) { names.push_back( j -> name() ); } );
+    range::for_each( m_running, [ &names ]( const std::shared_ptr<job_t>& j ) { names.push_back( j -> name() ); } );
+  }
+
+  range::for_each( names, [ this ]( const std::string& name ) { cancel( name ); } );
+}
+
+// pool_t::wait =============================================================
+
+void pool_t::wait()
+{
+  std::unique_lock<std::mutex> lock( m_mutex );
+  m_idle.wait( lock, [ this ]() { return m_queue.empty() && m_running.empty(); } );
+}
+
+// pool_t::shutdown =========================================================
+
+void pool_t::shutdown()
+{
+  {
+    std::lock_guard<std::mutex> lock( m_mutex );
+    m_shutdown = true;
+  }
+
+  m_work.notify_all();
+
+  range::for_each( m_workers, []( std::thread& t ) {
+    if ( t.joinable() )
+    {
+      t.join();
+    }
+  } );
+
+  m_workers.clear();
+}
+
+// compute_budget ===========================================================
+
+budget_t compute_budget( int threads, int jobs )
+{
+  // Same semantics as the threads option of a simulation, zero or negative values are relative to
+  // the number of hardware threads
+  if ( threads <= 0 )
+  {
+    threads = std::max( 1, static_cast<int>( sc_thread_t::cpu_thread_count() ) + threads );
+  }
+
+  // By default, run single-threaded simulations, one per available thread
+  if ( jobs <= 0 )
+  {
+    jobs = threads;
+  }
+
+  return { jobs, std::max( 1, threads / jobs ) };
+}
+
+// is_process_option ========================================================
+
+bool is_process_option( const option_tuple_t& opt )
+{
+  static const std::vector<std::string> process_opts {
+    "override.spell_data", "cache_items", "cache_players"
+  };
+
+  return range::find_if( process_opts, [ &opt ]( const std::string& name ) {
+    return util::str_compare_ci( opt.name, name );
+  } ) != process_opts.end();
+}
+
+// service_requested ========================================================
+
+bool service_requested( const option_db_t& options )
+{
+  return range::find_if( options, []( const option_tuple_t& opt ) {
+    return util::str_compare_ci( opt.name, "server" ) || util::str_compare_ci( opt.name, "batch" );
+  } ) != options.end();
+}
+
+// main =====================================================================
+
+int main( const option_db_t& options )
+{
+  std::string server_str, batch_output = ".";
+  std::vector<std::string> batch_paths;
+  int threads = 0, jobs = 0;
+
+  // Base options inherit the search paths and template variables of the command line
+  option_db_t base( options );
+  base.clear();
+
+  try
+  {
+    for ( const auto& opt : options )
+    {
+      if ( ! is_service_option( opt ) )
+      {
+        base.push_back( opt );
+      }
+      else if ( util::str_compare_ci( opt.name, "server" ) )
+      {
+        server_str = opt.value;
+      }
+      else if ( util::str_compare_ci( opt.name, "batch" ) )
+      {
+        batch_paths.push_back( opt.value );
+      }
+      else if ( util::str_compare_ci( opt.name, "batch_output" ) )
+      {
+        batch_output = opt.value;
+      }
+      else if ( util::str_compare_ci( opt.name, "concurrent_jobs" ) )
+      {
+        jobs = std::stoi( opt.value );
+      }
+      else if ( util::str_compare_ci( opt.name, "threads" ) )
+      {
+        threads = std::stoi( opt.value );
+      }
+    }
+  }
+  catch ( const std::exception& e )
+  {
+    std::cerr << "ERROR! Invalid service option: " << e.what() << std::endl;
+    return 1;
+  }
+
+  auto process_opt = range::find_if( base, is_process_option );
+  if ( process_opt != base.end() )
+  {
+    std::cerr << "ERROR! Option '" << process_opt -> name
+              << "' changes process-wide data, and cannot be used in server or batch mode" << std::endl;
+    return 1;
+  }
+
+  if ( ! server_str.empty() && ! batch_paths.empty() )
+  {
+    std::cerr << "ERROR! Server and batch modes cannot be used at the same time" << std::endl;
+    return 1;
+  }
+
+  if ( ! batch_paths.empty() )
+  {
+    return batch::run( batch_paths, batch_output, base, compute_budget( threads, jobs ) );
+  }
+
+  return server::serve( server_str, base, compute_budget( threads, jobs ) );
+}
+
+} // Namespace job ends
@@ -0,0 +1,143 @@
+// ==========================================================================
+// Dedmonwakeen's Raid DPS/TPS Simulator.
+// Send questions to natehieter@gmail.com
+// ==========================================================================
+#ifndef SC_JOB_HH
+#define SC_JOB_HH
+
+#include <atomic>
+#include <deque>
+#include <memory>
+#include <string>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+#include <vector>
+
+#include "util/generic.hpp"
+#include "sim/sc_option.hpp"
+
+struct sim_t;
+
+// Simulation jobs ==========================================================
+//
+// A job is a fully independent simulation (its own sim_t), described by option text. Jobs are
+// executed by a pool of worker threads that share the process-wide state (dbc, module static data,
+// special effect and hotfix databases) initialized once in sim_t::main. This allows a single
+// process to run large amounts of small simulations without paying the startup cost for each one.
+
+namespace job
+{
+enum job_state_e
+{
+  JOB_QUEUED,
+  JOB_RUNNING,
+  JOB_DONE,
+  JOB_FAILED,
+  JOB_CANCELED
+};
+
+enum job_report_e
+{
+  REPORT_FILES, // Output reports through report::print_suite, based on the options of the job
+  REPORT_JSON   // Collect the JSON v2 report into the job result
+};
+
+const char* job_state_string( job_state_e state );
+
+class job_t : private noncopyable
+{
+  std::string  m_name;
+  option_db_t  m_options;
+  job_report_e m_report;
+  // Read without locking by the pool, the worker, and the job's on_finish callback
+  std::atomic<job_state_e> m_state;
+  std::atomic<bool>        m_cancel;
+  sim_t*       m_sim;
+  std::string  m_result;
+  std::mutex   m_mutex;
+
+  void finish( job_state_e state, const std::string& result );
+
+public:
+  // Called from the worker thread, once the job is done, failed, or canceled
+  std::function<void(job_t&)> on_finish;
+
+  job_t( const std::string& name, const option_db_t& options, job_report_e report );
+
+  const std::string& name() const
+  { return m_name; }
+
+  job_state_e state() const
+  { return m_state; }
+
+  // JSON report of the simulation (REPORT_JSON), or an error message for failed jobs
+  const std::string& result() const
+  { return m_result; }
+
+  void run( int threads );
+  void cancel();
+};
+
+class pool_t : private noncopyable
+{
+  std::vector<std::thread>            m_workers;
+  std::deque<std::shared_ptr<job_t>>  m_queue;
+  std::vector<std::shared_ptr<job_t>> m_running;
+  std::mutex                          m_mutex;
+  std::condition_variable             m_work;
+  std::condition_variable             m_idle;
+  int                                 m_sim_threads;
+  bool                                m_shutdown;
+
+  void worker();
+
+public:
+  // Run at most n_jobs simultaneous jobs, with sim_threads threads per job
+  pool_t( int n_jobs, int sim_threads );
+  ~pool_t();
+
+  void submit( const std::shared_ptr<job_t>& job );
+  // Cancel a queued or running job, returns false if no such job exists
+  bool cancel( const std::string& name );
+  void cancel();
+  // Wait until all submitted jobs have finished
+  void wait();
+  void shutdown();
+};
+
+// Thread budget of the service, and its split into simultaneous jobs and threads per job
+struct budget_t
+{
+  int jobs;
+  int sim_threads;
+};
+
+budget_t compute_budget( int threads, int jobs );
+
+// True, if the option changes process-wide state (e.g., spell data overrides, cache behavior).
+// Such options cannot be used by jobs, as they would affect every other job the process runs.
+bool is_process_option( const option_tuple_t& opt );
+
+// True, if the (command line) options request a simulation service (server or batch mode) instead
+// of a simulation
+bool service_requested( const option_db_t& options );
+
+// Service entry point, global initialization is expected to be done by the caller
+int main( const option_db_t& options );
+
+namespace server
+{
+int serve( const std::string& endpoint, const option_db_t& base, const budget_t& budget );
+} // Namespace server ends
+
+namespace batch
+{
+int run( const std::vector<std::string>& paths, const std::string& output_dir, const option_db_t& base,
+         const budget_t& budget );
+} // Namespace batch ends
+
+} // Namespace job ends
+
+#endif /* SC_JOB_HH */
@@ -4,6 +4,8 @@
 // ==========================================================================
 
 #include "simulationcraft.hpp"
+#include <mutex>
+#include <thread>
 
 namespace
 {  // UNNAMED NAMESPACE ==========================================
@@ -50,12 +52,15 @@ plot_t::plot_t( sim_t* s )
     dps_plot_iterations( -1 ),
     dps_plot_target_error( 0 ),
     dps_plot_debug( 0 ),
+    dps_plot_parallel( 0 ),
     current_plot_stat( STAT_NONE ),
     num_plot_stats( 0 ),
     remaining_plot_stats( 0 ),
     remaining_plot_points( 0 ),
     dps_plot_positive( 0 ),
-    dps_plot_negative( 0 )
+    dps_plot_negative( 0 ),
+    num_plot_points( 0 ),
+    simulated_plot_points( 0 )
 {
   create_options();
 }
@@ -84,6 +89,18 @@ double plot_t::progress( std::string& phase, std::string* detailed )
   if ( num_plot_stats <= 0 )
     return 1;
 
+  // Plot points of all stats are simulated at once
+  if ( dps_plot_parallel > 1 )
+  {
+    phase = "Plot";
+
+    int completed = simulated_plot_points;
+
+    sim->detailed_progress( detailed, completed, num_plot_points );
+
+    return num_plot_points > 0 ? completed / (double)num_plot_points : 0;
+  }
+
   if ( current_plot_stat <= 0 )
     return 0;
 
@@ -123,18 +140,14 @@ void plot_t::analyze_stats()
       remaining_plot_stats++;
   num_plot_stats = remaining_plot_stats;
 
+  // Plot points of all stats, in plotting order. Point 0 is not simulated, the baseline is the main
+  // simulation.
+  std::vector<std::pair<stat_e, int>> points;
   for ( stat_e i = STAT_NONE; i < STAT_MAX; i++ )
   {
-    if ( sim->is_canceled() )
-      break;
-
     if ( !is_plot_stat( sim, i ) )
       continue;
 
-    current_plot_stat = i;
-
-    remaining_plot_points = dps_plot_points;
-
     int start, end;
 
     if ( dps_plot_positive )
@@ -155,69 +168,175 @@ void plot_t::analyze_stats()
 
     for ( int j = start; j <= end; j++ )
     {
-      if ( sim->is_canceled() )
-        break;
+      points.push_back( std::make_pair( i, j ) );
+    }
+  }
 
-      std::unique_ptr<sim_t> delta_sim;
+  num_plot_points = 0;
+  simulated_plot_points = 0;
+  for ( const auto& point : points )
+  {
+    if ( point.second != 0 )
+      num_plot_points++;
+  }
+
+  // Scaling metric of each player, for each plot point
+  std::vector<std::vector<plot_data_t>> results( points.size() );
+  simulate_points( points, results );
+
+  for ( size_t k = 0; k < points.size(); ++k )
+  {
+    stat_e i = points[ k ].first;
+    int j = points[ k ].second;
+
+    if ( j != 0 && results[ k ].empty() )
+      continue;
+
+    size_t player_idx = 0;
+    for ( player_t* p : sim->players_by_name )
+    {
+      if ( !p->scaling->scales_with[ i ] )
+        continue;
+
+      plot_data_t data;
 
       if ( j != 0 )
       {
-        delta_sim = std::unique_ptr<sim_t>( new sim_t( sim ) );
-        if ( dps_plot_iterations > 0 )
-        {
-          delta_sim->work_queue->init( dps_plot_iterations );
-        }
-        if ( dps_plot_target_error > 0 )
-          delta_sim->target_error = dps_plot_target_error;
-        //delta_sim->enchant.add_stat( i, j * dps_plot_step );
-        delta_sim->scaling->scale_stat = i;
-        delta_sim->scaling->scale_value = j * dps_plot_step;
-        delta_sim->progress_bar.set_base( util::to_string( j * dps_plot_step ) + " " + util::stat_type_abbrev( i ) );
-        delta_sim->execute();
-        if ( dps_plot_debug )
-        {
-          sim->out_debug.raw().printf( "Stat=%s Point=%d\n",
-                                       util::stat_type_string( i ), j );
-          report::print_text( delta_sim.get(), true );
-        }
+        data = results[ k ][ player_idx++ ];
       }
+      else
+      {
+        scaling_metric_data_t scaling_data =
+            p->scaling_for_metric( p->sim->scaling->scaling_metric );
+        data.value = scaling_data.value;
+        data.error = scaling_data.stddev * sim->confidence_estimator;
+      }
+      data.plot_step = j * dps_plot_step;
+      p->dps_plot_data[ i ].push_back( data );
+    }
+  }
+}
+
+// plot_t::simulate_points ==================================================
+
+/// Simulate plot points, with dps_plot_parallel > 1 the points are simulated concurrently on a
+/// pool of workers that split the threads of the simulation between them.
+void plot_t::simulate_points( const std::vector<std::pair<stat_e, int>>& points,
+                              std::vector<std::vector<plot_data_t>>& results )
+{
+  bool parallel = dps_plot_parallel > 1 && num_plot_points > 1;
+  // Simulators register with the parent simulator, and debug output is written by one point at
+  // a time
+  std::mutex mutex;
+
+  auto simulate = [ this, parallel, &points, &results, &mutex ]( size_t k ) {
+    stat_e i = points[ k ].first;
+    int j = points[ k ].second;
+
+    std::unique_ptr<sim_t> delta_sim;
+    {
+      std::lock_guard<std::mutex> lock( mutex );
+      delta_sim = std::unique_ptr<sim_t>( new sim_t( sim ) );
+    }
+
+    if ( dps_plot_iterations > 0 )
+    {
+      delta_sim->work_queue->init( dps_plot_iterations );
+    }
+    if ( dps_plot_target_error > 0 )
+      delta_sim->target_error = dps_plot_target_error;
+    if ( parallel )
+    {
+      delta_sim->threads = std::max( 1, sim->threads / dps_plot_parallel );
+      delta_sim->report_progress = 0;
+    }
+    //delta_sim->enchant.add_stat( i, j * dps_plot_step );
+    delta_sim->scaling->scale_stat = i;
+    delta_sim->scaling->scale_value = j * dps_plot_step;
+    delta_sim->progress_bar.set_base( util::to_string( j * dps_plot_step ) + " " + util::stat_type_abbrev( i ) );
+    delta_sim->execute();
+
+    std::lock_guard<std::mutex> lock( mutex );
 
-      for ( player_t* p : sim->players_by_name )
+    if ( dps_plot_debug )
+    {
+      sim->out_debug.raw().printf( "Stat=%s Point=%d\n",
+                                   util::stat_type_string( i ), j );
+      report::print_text( delta_sim.get(), true );
+    }
+
+    for ( player_t* p : sim->players_by_name )
+    {
+      if ( !p->scaling->scales_with[ i ] )
+        continue;
+
+      player_t* delta_p = delta_sim->find_player( p->name() );
+
+      scaling_metric_data_t scaling_data =
+          delta_p->scaling_for_metric( p->sim->scaling->scaling_metric );
+
+      plot_data_t data;
+      data.value = scaling_data.value;
+      data.error = scaling_data.stddev * delta_sim->confidence_estimator;
+      results[ k ].push_back( data );
+    }
+
+    simulated_plot_points++;
+
+    delta_sim.reset();
+  };
+
+  if ( ! parallel )
+  {
+    for ( size_t k = 0; k < points.size(); ++k )
+    {
+      if ( sim->is_canceled() )
+        break;
+
+      if ( points[ k ].first != current_plot_stat )
       {
-        if ( !p->scaling->scales_with[ i ] )
-          continue;
-
-        plot_data_t data;
-
-        if ( delta_sim )
-        {
-          player_t* delta_p = delta_sim->find_player( p->name() );
-
-          scaling_metric_data_t scaling_data =
-              delta_p->scaling_for_metric( p->sim->scaling->scaling_metric );
-
-          data.value = scaling_data.value;
-          data.error = scaling_data.stddev * delta_sim->confidence_estimator;
-        }
-        else
-        {
-          scaling_metric_data_t scaling_data =
-              p->scaling_for_metric( p->sim->scaling->scaling_metric );
-          data.value = scaling_data.value;
-          data.error = scaling_data.stddev * sim->confidence_estimator;
-        }
-        data.plot_step = j * dps_plot_step;
-        p->dps_plot_data[ i ].push_back( data );
+        if ( current_plot_stat != STAT_NONE )
+          remaining_plot_stats--;
+        current_plot_stat = points[ k ].first;
+        remaining_plot_points = dps_plot_points;
       }
 
-      if ( delta_sim )
+      if ( points[ k ].second != 0 )
       {
+        simulate( k );
         remaining_plot_points--;
       }
     }
 
-    remaining_plot_stats--;
+    remaining_plot_stats = 0;
+    return;
+  }
+
+  std::atomic<size_t> next_point( 0 );
+  auto work = [ this, &points, &next_point, &simulate ]() {
+    size_t k;
+    while ( ( k = next_point++ ) < points.size() )
+    {
+      if ( sim->is_canceled() )
+        break;
+
+      if ( points[ k ].second != 0 )
+      {
+        simulate( k );
+      }
+    }
+  };
+
+  std::vector<std::thread> workers;
+  for ( int i = 1, end = std::min( dps_plot_parallel, num_plot_points ); i < end; ++i )
+  {
+    workers.emplace_back( work );
   }
+
+  work();
+  range::for_each( workers, []( std::thread& t ) { t.join(); } );
+
+  remaining_plot_stats = 0;
 }
 
 void plot_t::write_output_file()
@@ -271,6 +390,7 @@ void plot_t::create_options()
   sim->add_option( opt_string( "dps_plot_stat", dps_plot_stat_str ) );
   sim->add_option( opt_float( "dps_plot_step", dps_plot_step ) );
   sim->add_option( opt_bool( "dps_plot_debug", dps_plot_debug ) );
+  sim->add_option( opt_int( "dps_plot_parallel", dps_plot_parallel ) );
   sim->add_option( opt_bool( "dps_plot_positive", dps_plot_positive ) );
   sim->add_option( opt_bool( "dps_plot_negative", dps_plot_negative ) );
 }
@@ -311,6 +311,12 @@ void profilesets_t::initialize( sim_t* sim )
     return;
   }
 
+  // Reported simulations load the profileset results from the result file
+  if ( ! sim -> load_results_file_str.empty() )
+  {
+    return;
+  }
+
   m_profilesets.reserve( sim -> profileset_map.size() + 1 );
 
   m_thread = std::thread([ this, sim ]() {
@@ -392,8 +398,12 @@ bool profilesets_t::iterate( sim_t* parent )
 
     auto profile_sim = new sim_t( parent );
 
-    // Reset random seed for the profileset sims
-    profile_sim -> seed = 0;
+    // Reset random seed for the profileset sims. With common random numbers, profilesets keep the
+    // seed of the baseline simulation, so their iterations see the same random numbers.
+    if ( ! parent -> common_random_numbers )
+    {
+      profile_sim -> seed = 0;
+    }
     profile_sim -> profileset_enabled = true;
     profile_sim -> report_details = 0;
     profile_sim -> progress_bar.set_base( "Profileset" );
@@ -467,6 +477,79 @@ int profilesets_t::max_name_length() const
   return as<int>(len);
 }
 
+void profilesets_t::serialize( archive_t& ar )
+{
+  if ( ar.saving() )
+  {
+    ar.write( static_cast<uint64_t>( m_profilesets.size() ) );
+    for ( const auto& profileset : m_profilesets )
+    {
+      const profile_set_t& set = *profileset;
+
+      // The first result is the primary metric
+      std::vector<const profile_result_t*> results;
+      if ( set.results() > 0 )
+      {
+        results.push_back( &set.result() );
+      }
+
+      for ( scale_metric_e m = SCALE_METRIC_NONE; m < SCALE_METRIC_MAX; ++m )
+      {
+        const auto& result = set.result( m );
+        if ( m != SCALE_METRIC_NONE && result.metric() == m && &result != results.front() )
+        {
+          results.push_back( &result );
+        }
+      }
+
+      ar.write( set.name() );
+      ar.write( set.has_output() );
+      ar.write( static_cast<uint64_t>( results.size() ) );
+      for ( const auto result : results )
+      {
+        ar.write( result -> metric() );
+        ar.write( result -> mean() );
+        ar.write( result -> median() );
+        ar.write( result -> min() );
+        ar.write( result -> max() );
+        ar.write( result -> first_quartile() );
+        ar.write( result -> third_quartile() );
+        ar.write( result -> stddev() );
+        ar.write( static_cast<uint64_t>( result -> iterations() ) );
+      }
+    }
+    return;
+  }
+
+  m_profilesets.clear();
+  for ( auto n = ar.read<uint64_t>(); n > 0; --n )
+  {
+    std::string name;
+    ar.read( name );
+    // Output data (gear, talents) of the profilesets is not saved
+    ar.read<bool>();
+
+    std::unique_ptr<profile_set_t> set( new profile_set_t( name, nullptr, false ) );
+    for ( auto i = ar.read<uint64_t>(); i > 0; --i )
+    {
+      auto metric = ar.read<scale_metric_e>();
+      auto& result = set -> result( metric );
+      result.mean( ar.read<double>() );
+      result.median( ar.read<double>() );
+      result.min( ar.read<double>() );
+      result.max( ar.read<double>() );
+      result.first_quartile( ar.read<double>() );
+      result.third_quartile( ar.read<double>() );
+      result.stddev( ar.read<double>() );
+      result.iterations( static_cast<size_t>( ar.read<uint64_t>() ) );
+    }
+
+    m_profilesets.push_back( std::move( set ) );
+  }
+
+  set_state( DONE );
+}
+
 void profilesets_t::output( const sim_t& sim, js::JsonOutput& root ) const
 {
   root[ "metric" ] = util::scale_metric_type_string( sim.profileset_metric.front() );
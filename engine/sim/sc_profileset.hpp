@@ -20,6 +20,7 @@ struct sim_control_t;
 struct player_t;
 class extended_sample_data_t;
 struct talent_data_t;
+class archive_t;
 
 namespace js {
 struct JsonOutput;
@@ -328,6 +329,9 @@ public:
   void output( const sim_t& sim, FILE* out ) const;
   void output( const sim_t& sim, io::ofstream& out ) const;
 
+  // Save the results of the profilesets, or replace the profilesets with saved results
+  void serialize( archive_t& ar );
+
   bool is_initializing() const
   { return m_state == INITIALIZING; }
 
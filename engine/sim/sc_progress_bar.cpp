@@ -5,6 +5,73 @@
 
 #include "simulationcraft.hpp"
 
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+namespace
+{
+// Quote and escape a string for the JSON progress output
+std::string json_string( const std::string& str )
+{
+  std::string out = "\"";
+  for ( char c : str )
+  {
+    switch ( c )
+    {
+      case '"':  out += "\\\""; break;
+      case '\\': out += "\\\\"; break;
+      case '\n': out += "\\n"; break;
+      case '\r': out += "\\r"; break;
+      case '\t': out += "\\t"; break;
+      default:
+        if ( static_cast<unsigned char>( c ) < 0x20 )
+        {
+          str::format( out, "\\u%04x", static_cast<unsigned>( c ) );
+        }
+        else
+        {
+          out += c;
+        }
+        break;
+    }
+  }
+  out += "\"";
+  return out;
+}
+} // unnamed namespace
+
+// Progress reporter thread. The simulator threads only count their completed iterations in relaxed
+// atomic counters, the reporter wakes up every max_interval_time seconds to sum the counters, and
+// to format and output the progress bar.
+struct progress_bar_t::reporter_t
+{
+  std::mutex mutex;
+  std::condition_variable cv;
+  bool stop;
+  std::thread thread;
+  // Counted iterations that do not belong to the current phase, negative for the iterations a
+  // resumed simulation starts with
+  int base;
+  // Iterations of a phase, projected by the main thread in target_error simulations
+  int total;
+
+  reporter_t() : stop( false ), base( 0 ), total( 0 )
+  { }
+
+  // Iterations completed by the main thread and its children, the children are created before, and
+  // destroyed after the simulation iterates
+  static int work( const sim_t& sim )
+  {
+    int n = sim.progress_work.load( std::memory_order_relaxed );
+    for ( const sim_t* child : sim.children )
+    {
+      n += child -> progress_work.load( std::memory_order_relaxed );
+    }
+    return n;
+  }
+};
+
 std::string progress_bar_t::format_time( double t )
 {
   std::stringstream s;
@@ -58,6 +125,11 @@ progress_bar_t::progress_bar_t( sim_t& s ) :
 {
 }
 
+progress_bar_t::~progress_bar_t()
+{
+  stop_reporter();
+}
+
 void progress_bar_t::init()
 {
   start_time = util::wall_time();
@@ -128,12 +200,117 @@ bool progress_bar_t::update( bool finished, int index )
   {
     return update_simple( progress, finished, index );
   }
+  else if ( sim.progressbar_type == 2 )
+  {
+    return update_json( progress, finished, index );
+  }
   else
   {
     return update_normal( progress, finished, index );
   }
 }
 
+void progress_bar_t::start_reporter()
+{
+  if ( reporter || sim.thread_index != 0 || ! sim.report_progress || ! sim.progressbar_thread )
+  {
+    return;
+  }
+
+  reporter.reset( new reporter_t() );
+  auto start = sim.progress( nullptr );
+  reporter -> base = reporter_t::work( sim ) - start.current_iterations;
+  reporter -> total = start.total_iterations;
+  reporter -> thread = std::thread( [ this ]() {
+    std::unique_lock<std::mutex> lock( reporter -> mutex );
+    while ( ! reporter -> stop )
+    {
+      reporter -> cv.wait_for( lock, std::chrono::duration<double>( max_interval_time ) );
+      if ( reporter -> stop || sim.canceled )
+      {
+        continue;
+      }
+
+      // Only the projected total of target_error simulations needs the work queue
+      auto progress = sim_progress_t{ reporter_t::work( sim ) - reporter -> base, reporter -> total };
+      if ( sim.target_error > 0 )
+      {
+        progress.total_iterations = sim.progress( nullptr ).total_iterations;
+      }
+      if ( progress.current_iterations <= 0 || progress.total_iterations <= 0 )
+      {
+        continue;
+      }
+
+      if ( sim.target_error > 0 && progress.current_iterations < sim.analyze_error_interval )
+      {
+        continue;
+      }
+
+      bool updated;
+      if ( sim.progressbar_type == 1 )
+      {
+        updated = update_simple( progress, false, -1 );
+      }
+      else if ( sim.progressbar_type == 2 )
+      {
+        updated = update_json( progress, false, -1 );
+      }
+      else
+      {
+        updated = update_normal( progress, false, -1 );
+      }
+
+      if ( updated )
+      {
+        output( false );
+      }
+    }
+  } );
+}
+
+void progress_bar_t::stop_reporter()
+{
+  if ( ! reporter )
+  {
+    return;
+  }
+
+  {
+    std::lock_guard<std::mutex> lock( reporter -> mutex );
+    reporter -> stop = true;
+  }
+  reporter -> cv.notify_one();
+  reporter -> thread.join();
+  reporter.reset();
+}
+
+bool progress_bar_t::reporting() const
+{
+  return reporter != nullptr;
+}
+
+void progress_bar_t::finish_phase( int index )
+{
+  // The reporter may be in the middle of an update of the (shared) status of the progress bar
+  std::unique_lock<std::mutex> lock;
+  if ( reporter )
+  {
+    lock = std::unique_lock<std::mutex>( reporter -> mutex );
+  }
+
+  if ( update( true, index ) )
+  {
+    output( true );
+  }
+  restart();
+
+  if ( reporter )
+  {
+    reporter -> base = reporter_t::work( sim );
+  }
+}
+
 bool progress_bar_t::update_simple( const sim_progress_t& progress, bool finished, int /* index */ )
 {
   auto pct = progress.pct();
@@ -158,9 +335,9 @@ bool progress_bar_t::update_simple( const sim_progress_t& progress, bool finishe
   if ( sim.target_error > 0 )
   {
     status += '\t';
-    status += util::to_string( sim.current_mean );
+    status += util::to_string( sim.current_mean.load() );
     status += '\t';
-    status += util::to_string( sim.current_error );
+    status += util::to_string( sim.current_error.load() );
   }
 
   if ( remaining_time > 0 )
@@ -239,7 +416,7 @@ bool progress_bar_t::update_normal( const sim_progress_t& progress, bool finishe
 
   if ( sim.target_error > 0 )
   {
-    str::format( status, " Mean=%.0f Error=%.3f%%", sim.current_mean, sim.current_error );
+    str::format( status, " Mean=%.0f Error=%.3f%%", sim.current_mean.load(), sim.current_error.load() );
   }
 
   if ( remaining_min > 0 )
@@ -301,6 +478,46 @@ bool progress_bar_t::update_normal( const sim_progress_t& progress, bool finishe
   return true;
 }
 
+bool progress_bar_t::update_json( const sim_progress_t& progress, bool finished, int /* index */ )
+{
+  auto pct = progress.pct();
+  if ( pct <= 0 )
+  {
+    return false;
+  }
+
+  if ( finished )
+  {
+    pct = 1.0;
+  }
+
+  double current_time = util::wall_time() - start_time;
+  double remaining_time = finished ? 0 : std::max( 0.0, current_time / pct - current_time );
+
+  status.clear();
+  str::format( status, "\"iterations\":%d,\"total_iterations\":%d",
+               finished ? progress.total_iterations : progress.current_iterations,
+               progress.total_iterations );
+  str::format( status, ",\"elapsed\":%.3f,\"remaining\":%.3f", current_time, remaining_time );
+
+  if ( sim.target_error > 0 )
+  {
+    str::format( status, ",\"mean\":%.3f,\"error\":%.5f", sim.current_mean.load(), sim.current_error.load() );
+  }
+
+  if ( ! finished && total_work() > 0 )
+  {
+    auto average_spent = average_simulation_time();
+    auto phases_left = total_work() - current_progress();
+    auto time_left = std::max( 0.0, average_spent - current_time );
+    str::format( status, ",\"total_remaining\":%.3f", phases_left * average_spent + time_left );
+  }
+
+  str::format( status, ",\"finished\":%s", finished ? "true" : "false" );
+
+  return true;
+}
+
 void progress_bar_t::output( bool finished )
 {
   if ( ! sim.report_progress )
@@ -308,6 +525,24 @@ void progress_bar_t::output( bool finished )
     return;
   }
 
+  // One JSON object per line
+  if ( sim.progressbar_type == 2 )
+  {
+    std::stringstream s;
+    s << "{\"base\":" << json_string( base_str );
+    if ( ! phase_str.empty() )
+    {
+      s << ",\"phase\":" << json_string( phase_str );
+    }
+    s << ",\"step\":" << current_progress();
+    s << ",\"steps\":" << compute_total_phases();
+    s << "," << status << "}\n";
+
+    std::cout << s.str();
+    fflush( stdout );
+    return;
+  }
+
   char delim = sim.progressbar_type == 1 ? '\t' : ' ';
   char terminator = ( sim.progressbar_type == 1 || finished ) ? '\n' : '\r';
   std::stringstream s;
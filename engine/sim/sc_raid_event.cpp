@@ -205,7 +205,7 @@ struct adds_event_t : public raid_event_t
 
   void _start() override
   {
-    adds_to_remove = static_cast<size_t>( util::round( std::max( 0.0, sim -> rng().range( count - count_range, count + count_range ) ) ) );
+    adds_to_remove = static_cast<size_t>( util::round( std::max( 0.0, sim -> raid_event_rng().range( count - count_range, count + count_range ) ) ) );
 
     double x_offset = 0;
     double y_offset = 0;
@@ -221,8 +221,8 @@ struct adds_event_t : public raid_event_t
           {
             double angle_start = spawn_angle_start * ( M_PI / 180 );
             double angle_end = spawn_angle_end * ( M_PI / 180 );
-            double angle = sim -> rng().range( angle_start, angle_end );
-            double radius = sim -> rng().range( fabs( spawn_radius_min ), fabs( spawn_radius_max ) );
+            double angle = sim -> raid_event_rng().range( angle_start, angle_end );
+            double radius = sim -> raid_event_rng().range( fabs( spawn_radius_min ), fabs( spawn_radius_max ) );
             x_offset = radius * cos(angle);
             y_offset = radius * sin(angle);
             offset_computed = true;
@@ -597,16 +597,16 @@ struct movement_event_t : public raid_event_t
     movement_direction_e m = direction;
     if ( direction == MOVEMENT_RANDOM )
     {
-      m = static_cast<movement_direction_e>( int( sim -> rng().range( MOVEMENT_RANDOM_MIN, MOVEMENT_RANDOM_MAX ) ) );
+      m = static_cast<movement_direction_e>( int( sim -> raid_event_rng().range( MOVEMENT_RANDOM_MIN, MOVEMENT_RANDOM_MAX ) ) );
     }
 
     if ( distance_range > 0 )
     {
-      move = sim -> rng().range( move_distance - distance_range, move_distance + distance_range );
+      move = sim -> raid_event_rng().range( move_distance - distance_range, move_distance + distance_range );
       if ( move < distance_min ) move = distance_min;
       else if ( move > distance_max ) move = distance_max;
     }
-    else if ( distance_min > 0 || distance_max > 0 ) move = sim -> rng().range( distance_min, distance_max );
+    else if ( distance_min > 0 || distance_max > 0 ) move = sim -> raid_event_rng().range( distance_min, distance_max );
     else move = move_distance;
 
     if ( move <= 0.0 ) return;
@@ -739,7 +739,7 @@ struct damage_event_t : public raid_event_t
     for (auto p : affected_players)
     {
       
-      raid_damage -> base_dd_min = raid_damage -> base_dd_max = sim -> rng().range( amount - amount_range, amount + amount_range );
+      raid_damage -> base_dd_min = raid_damage -> base_dd_max = sim -> raid_event_rng().range( amount - amount_range, amount + amount_range );
       raid_damage -> target = p;
       raid_damage -> execute();
     }
@@ -781,7 +781,7 @@ struct heal_event_t : public raid_event_t
       {
         double pct_actual = to_pct;
         if ( to_pct_range > 0 )
-          pct_actual = sim -> rng().range( to_pct - to_pct_range, to_pct + to_pct_range );
+          pct_actual = sim -> raid_event_rng().range( to_pct - to_pct_range, to_pct + to_pct_range );
         if ( sim -> debug )
           sim -> out_debug.printf( "%s healing to %.3f%% (%.0f) of max health, current health %.0f",
               p -> name(), pct_actual, p -> resources.max[ RESOURCE_HEALTH ] * pct_actual / 100,
@@ -791,7 +791,7 @@ struct heal_event_t : public raid_event_t
       }
       else
       {
-        x = sim -> rng().range( amount - amount_range, amount + amount_range );
+        x = sim -> raid_event_rng().range( amount - amount_range, amount + amount_range );
         p -> resource_gain( RESOURCE_HEALTH, x );
       }
 
@@ -998,7 +998,7 @@ timespan_t raid_event_t::cooldown_time()
   }
   else
   {
-    time = sim -> rng().gauss( cooldown, cooldown_stddev );
+    time = sim -> raid_event_rng().gauss( cooldown, cooldown_stddev );
 
     time = clamp( time, cooldown_min, cooldown_max );
   }
@@ -1010,7 +1010,7 @@ timespan_t raid_event_t::cooldown_time()
 
 timespan_t raid_event_t::duration_time()
 {
-  timespan_t time = sim -> rng().gauss( duration, duration_stddev );
+  timespan_t time = sim -> raid_event_rng().gauss( duration, duration_stddev );
 
   time = clamp( time, duration_min, duration_max );
 
@@ -1301,7 +1301,7 @@ bool raid_event_t::filter_player( const player_t* p )
   if ( p -> is_pet() && players_only )
     return true;
 
-  if ( ! sim -> rng().roll( player_chance ) )
+  if ( ! sim -> raid_event_rng().roll( player_chance ) )
     return true;
 
   if ( affected_role != ROLE_NONE && p -> role != affected_role )
@@ -37,6 +37,79 @@ bool is_plot_stat( sim_t* sim, stat_e stat )
   return it != sim->player_no_pet_list.end();
 }
 
+/// Quadratic response surface over the reforge combinations. The mod of the last stat balances the
+/// others, so the surface is a function of the mods of all but the last stat.
+struct response_surface_t
+{
+  double scale;
+  std::vector<double> coefficients, inverse;
+  double variance;
+
+  response_surface_t( double s ) : scale( s ), variance( 0 )
+  { }
+
+  std::vector<double> terms( const std::vector<int>& stat_mods ) const
+  {
+    std::vector<double> x;
+    for ( size_t i = 0; i + 1 < stat_mods.size(); ++i )
+      x.push_back( stat_mods[ i ] / scale );
+
+    std::vector<double> t( 1, 1.0 );
+    t.insert( t.end(), x.begin(), x.end() );
+    for ( size_t i = 0; i < x.size(); ++i )
+      for ( size_t j = i; j < x.size(); ++j )
+        t.push_back( x[ i ] * x[ j ] );
+
+    return t;
+  }
+
+  // Fit the surface to simulated values, weighting each value by its error
+  bool fit( const std::vector<std::vector<int>>& stat_mods, const std::vector<size_t>& points,
+            const std::vector<double>& values, const std::vector<double>& errors )
+  {
+    std::vector<double> x, w;
+    for ( size_t i = 0; i < points.size(); ++i )
+    {
+      std::vector<double> t = terms( stat_mods[ points[ i ] ] );
+      x.insert( x.end(), t.begin(), t.end() );
+      w.push_back( 1.0 / std::max( errors[ i ] * errors[ i ], 1e-6 ) );
+    }
+
+    size_t k = terms( stat_mods[ points.front() ] ).size();
+    return statistics::least_squares( x, values, w, k, coefficients, inverse, variance );
+  }
+
+  double value( const std::vector<int>& stat_mods ) const
+  {
+    std::vector<double> t = terms( stat_mods );
+    double v = 0;
+    for ( size_t i = 0; i < t.size(); ++i )
+      v += coefficients[ i ] * t[ i ];
+    return v;
+  }
+
+  // Error of the fitted value, the errors of the simulated values are inflated if the surface does
+  // not fit them
+  double error( const std::vector<int>& stat_mods ) const
+  {
+    std::vector<double> t = terms( stat_mods );
+    double v = 0;
+    for ( size_t i = 0; i < t.size(); ++i )
+      for ( size_t j = 0; j < t.size(); ++j )
+        v += t[ i ] * inverse[ i * t.size() + j ] * t[ j ];
+    return sqrt( std::max( variance, 1.0 ) * v );
+  }
+};
+
+/// Squared distance between two reforge combinations
+double distance( const std::vector<int>& a, const std::vector<int>& b )
+{
+  double d = 0;
+  for ( size_t i = 0; i < a.size(); ++i )
+    d += static_cast<double>( a[ i ] - b[ i ] ) * ( a[ i ] - b[ i ] );
+  return d;
+}
+
 }  // UNNAMED NAMESPACE ====================================================
 
 // ==========================================================================
@@ -53,6 +126,7 @@ reforge_plot_t::reforge_plot_t( sim_t* s )
     reforge_plot_iterations( -1 ),
     reforge_plot_target_error( 0 ),
     reforge_plot_debug( 0 ),
+    reforge_plot_adaptive( 0 ),
     current_stat_combo( -1 ),
     num_stat_combos( 0 )
 {
@@ -162,64 +236,216 @@ void reforge_plot_t::analyze_stats()
     }
   }
 
-  for ( size_t i = 0; i < stat_mods.size(); i++ )
+  std::vector<std::vector<std::vector<plot_data_t>>> results( stat_mods.size() );
+
+  if ( reforge_plot_adaptive > 0 && as<size_t>( reforge_plot_adaptive ) < stat_mods.size() &&
+       reforge_plot_stat_indices.size() > 1 )
   {
-    if ( sim->is_canceled() )
-      break;
+    num_stat_combos = reforge_plot_adaptive;
+    select_adaptive( stat_mods, results );
+  }
+  else
+  {
+    for ( size_t i = 0; i < stat_mods.size(); i++ )
+    {
+      if ( sim->is_canceled() )
+        break;
 
-    std::vector<plot_data_t> delta_result( stat_mods[ i ].size() + 1 );
+      current_stat_combo = as<int>( i );
+      simulate( stat_mods[ i ], results[ i ] );
+    }
+  }
 
-    current_reforge_sim = new sim_t( sim );
-    if ( reforge_plot_iterations > 0 )
+  // Results are reported in the order of the reforge combinations
+  for ( size_t i = 0; i < stat_mods.size(); i++ )
+  {
+    for ( size_t j = 0; j < results[ i ].size(); ++j )
     {
-      current_reforge_sim->work_queue->init( reforge_plot_iterations );
+      sim->players_by_name[ j ]->reforge_plot_data.push_back( results[ i ][ j ] );
     }
+  }
+}
+
+// reforge_plot_t::simulate =================================================
 
-    std::stringstream s;
-    for ( size_t j = 0; j < stat_mods[ i ].size(); j++ )
+/// Simulate a reforge combination, results holds the combination and the resulting metric of each
+/// player
+bool reforge_plot_t::simulate( const std::vector<int>& stat_mods,
+                               std::vector<std::vector<plot_data_t>>& results )
+{
+  std::vector<plot_data_t> delta_result( stat_mods.size() + 1 );
+
+  current_reforge_sim = new sim_t( sim );
+  if ( reforge_plot_iterations > 0 )
+  {
+    current_reforge_sim->work_queue->init( reforge_plot_iterations );
+  }
+
+  std::stringstream s;
+  for ( size_t j = 0; j < stat_mods.size(); j++ )
+  {
+    stat_e stat = reforge_plot_stat_indices[ j ];
+    int mod     = stat_mods[ j ];
+
+    current_reforge_sim -> enchant.add_stat( stat, mod );
+    delta_result[ j ].value = mod;
+    delta_result[ j ].error = 0;
+
+    s << util::to_string( mod ) << " " << util::stat_type_abbrev( stat );
+    if ( j < stat_mods.size() - 1 )
     {
-      stat_e stat = reforge_plot_stat_indices[ j ];
-      int mod     = stat_mods[ i ][ j ];
+      s << ", ";
+    }
+  }
+
+  current_reforge_sim -> progress_bar.set_base( s.str() );
+  current_reforge_sim -> execute();
+
+  results.clear();
+  for ( player_t* player : sim->players_by_name )
+  {
+    plot_data_t& data = delta_result[ stat_mods.size() ];
+    player_t* delta_p = current_reforge_sim->find_player( player->name() );
 
-      current_reforge_sim -> enchant.add_stat( stat, mod );
-      delta_result[ j ].value = mod;
-      delta_result[ j ].error = 0;
+    scaling_metric_data_t scaling_data =
+        delta_p->scaling_for_metric( player->sim->scaling->scaling_metric );
 
-      s << util::to_string( mod ) << " " << util::stat_type_abbrev( stat );
-      if ( j < stat_mods[ i ].size() - 1 )
+    data.value = scaling_data.value;
+    data.error =
+        scaling_data.stddev * current_reforge_sim->confidence_estimator;
+
+    results.push_back( delta_result );
+  }
+
+  delete current_reforge_sim;
+  current_reforge_sim = nullptr;
+
+  return ! sim->is_canceled();
+}
+
+// reforge_plot_t::select_adaptive ==========================================
+
+/// Simulate reforge_plot_adaptive combinations. The first half is a space-filling design (each
+/// combination is the one farthest from all combinations simulated so far, starting from the
+/// unreforged baseline). The rest refines the plot near the optimum: each combination maximizes the
+/// upper error bound of a quadratic response surface fitted to the summed metric of all players.
+/// Finally, the surface of each player is fitted to the simulated combinations.
+std::vector<size_t> reforge_plot_t::select_adaptive(
+    const std::vector<std::vector<int>>& stat_mods,
+    std::vector<std::vector<std::vector<plot_data_t>>>& results )
+{
+  size_t n_stats = reforge_plot_stat_indices.size();
+  size_t budget = as<size_t>( reforge_plot_adaptive );
+  size_t n_initial = std::max( budget / 2, std::min( budget, n_stats + 1 ) );
+
+  std::vector<size_t> points;
+  std::vector<double> min_distance( stat_mods.size(), std::numeric_limits<double>::max() );
+  std::vector<int> baseline( n_stats );
+
+  auto add_point = [ & ]( size_t index ) {
+    current_stat_combo = as<int>( points.size() );
+    points.push_back( index );
+    for ( size_t i = 0; i < stat_mods.size(); ++i )
+    {
+      min_distance[ i ] = std::min( min_distance[ i ], distance( stat_mods[ i ], stat_mods[ index ] ) );
+    }
+    return simulate( stat_mods[ index ], results[ index ] );
+  };
+
+  // Farthest unsimulated combination, or the one closest to the baseline if nothing was simulated
+  auto farthest_point = [ & ]() {
+    size_t best = 0;
+    double best_value = -std::numeric_limits<double>::max();
+    for ( size_t i = 0; i < stat_mods.size(); ++i )
+    {
+      if ( ! results[ i ].empty() )
+        continue;
+
+      double v = points.empty() ? -distance( stat_mods[ i ], baseline ) : min_distance[ i ];
+      if ( v > best_value )
       {
-        s << ", ";
+        best = i;
+        best_value = v;
       }
     }
+    return best;
+  };
 
-    current_stat_combo = as<int>( i );
-    current_reforge_sim -> progress_bar.set_base( s.str() );
-    current_reforge_sim -> execute();
-
-    for ( player_t* player : sim->players_by_name )
+  auto summed_metric = [ & ]( size_t index, double& value, double& error ) {
+    value = error = 0;
+    for ( const auto& player_result : results[ index ] )
     {
-      if ( current_reforge_sim )
-      {
-        plot_data_t& data = delta_result[ stat_mods[ i ].size() ];
-        player_t* delta_p = current_reforge_sim->find_player( player->name() );
+      value += player_result.back().value;
+      error += player_result.back().error * player_result.back().error;
+    }
+    error = sqrt( error );
+  };
 
-        scaling_metric_data_t scaling_data =
-            delta_p->scaling_for_metric( player->sim->scaling->scaling_metric );
+  while ( points.size() < n_initial )
+  {
+    if ( ! add_point( farthest_point() ) )
+      return points;
+  }
 
-        data.value = scaling_data.value;
-        data.error =
-            scaling_data.stddev * current_reforge_sim->confidence_estimator;
+  while ( points.size() < budget )
+  {
+    std::vector<double> values( points.size() ), errors( points.size() );
+    for ( size_t i = 0; i < points.size(); ++i )
+      summed_metric( points[ i ], values[ i ], errors[ i ] );
 
-        player->reforge_plot_data.push_back( delta_result );
+    response_surface_t surface( reforge_plot_amount );
+    size_t next = farthest_point();
+    if ( surface.fit( stat_mods, points, values, errors ) )
+    {
+      double best_value = -std::numeric_limits<double>::max();
+      for ( size_t i = 0; i < stat_mods.size(); ++i )
+      {
+        if ( ! results[ i ].empty() )
+          continue;
+
+        double v = surface.value( stat_mods[ i ] ) + surface.error( stat_mods[ i ] );
+        if ( v > best_value )
+        {
+          next = i;
+          best_value = v;
+        }
       }
     }
 
-    if ( current_reforge_sim )
+    if ( ! add_point( next ) )
+      return points;
+  }
+
+  // Fitted surface of each player, evaluated at every combination
+  for ( size_t j = 0; j < sim->players_by_name.size(); ++j )
+  {
+    std::vector<double> values, errors;
+    for ( size_t index : points )
+    {
+      values.push_back( results[ index ][ j ].back().value );
+      errors.push_back( results[ index ][ j ].back().error );
+    }
+
+    response_surface_t surface( reforge_plot_amount );
+    if ( ! surface.fit( stat_mods, points, values, errors ) )
+      continue;
+
+    player_t* player = sim->players_by_name[ j ];
+    for ( const auto& mods : stat_mods )
     {
-      delete current_reforge_sim;
-      current_reforge_sim = nullptr;
+      std::vector<plot_data_t> row( n_stats + 1 );
+      for ( size_t i = 0; i < n_stats; ++i )
+      {
+        row[ i ].value = mods[ i ];
+        row[ i ].error = 0;
+      }
+      row[ n_stats ].value = surface.value( mods );
+      row[ n_stats ].error = surface.error( mods );
+      player->reforge_plot_surface.push_back( row );
     }
   }
+
+  return points;
 }
 
 void reforge_plot_t::write_output_file()
@@ -261,6 +487,27 @@ void reforge_plot_t::write_output_file()
       out << plot_data_list.back().error << ", ";
       out << "\n";
     }
+
+    if ( player->reforge_plot_surface.empty() )
+      continue;
+
+    out << player->name() << " Reforge Plot Fitted Surface:\n";
+
+    for ( stat_e stat_index : reforge_plot_stat_indices )
+    {
+      out << util::stat_type_string( stat_index ) << ", ";
+    }
+    out << " DPS, DPS-Error\n";
+
+    for ( const auto& plot_data_list : player->reforge_plot_surface )
+    {
+      for ( const plot_data_t& plot_data : plot_data_list )
+      {
+        out << plot_data.value << ", ";
+      }
+      out << plot_data_list.back().error << ", ";
+      out << "\n";
+    }
   }
 }
 
@@ -338,4 +585,5 @@ void reforge_plot_t::create_options()
   sim->add_option( opt_int( "reforge_plot_amount", reforge_plot_amount ) );
   sim->add_option( opt_string( "reforge_plot_stat", reforge_plot_stat_str ) );
   sim->add_option( opt_bool( "reforge_plot_debug", reforge_plot_debug ) );
+  sim->add_option( opt_int( "reforge_plot_adaptive", reforge_plot_adaptive ) );
 }
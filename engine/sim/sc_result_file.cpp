@@ -0,0 +1,340 @@
+// ==========================================================================
+// Dedmonwakeen's Raid DPS/TPS Simulator.
+// Send questions to natehieter@gmail.com
+// ==========================================================================
+
+#include "simulationcraft.hpp"
+#include "sc_result_file.hpp"
+#include "sc_profileset.hpp"
+
+namespace
+{
+const uint32_t RESULT_MAGIC   = 0x53524353; // "SCRS"
+const uint32_t RESULT_VERSION = 2;
+
+// Options that only select the output or the execution of the simulation, they can differ between
+// the simulation saving the results and the one loading them
+const char* const OUTPUT_OPTIONS[] = {
+  "save_results", "load_results", "html", "json", "json2", "hosted_html", "xml", "xml_style",
+  "output", "log", "debug", "threads", "iterations", "target_error", "process_priority"
+};
+const char* const OUTPUT_OPTION_PREFIXES[] = { "report_", "chart_", "checkpoint" };
+
+bool output_option( const std::string& name )
+{
+  return range::find_if( OUTPUT_OPTIONS, [ &name ]( const char* o ) { return util::str_compare_ci( name, o ); } ) !=
+           std::end( OUTPUT_OPTIONS ) ||
+         range::find_if( OUTPUT_OPTION_PREFIXES, [ &name ]( const char* o ) { return util::str_prefix_ci( name, o ); } ) !=
+           std::end( OUTPUT_OPTION_PREFIXES );
+}
+
+// FNV-1a hash of the simulation options and the initialized actors, results can only be loaded
+// into the same simulation
+uint64_t fingerprint( const sim_t& sim )
+{
+  uint64_t hash = 14695981039346656037ULL;
+  auto add = [ &hash ]( const std::string& str ) {
+    for ( unsigned char c : str )
+    {
+      hash ^= c;
+      hash *= 1099511628211ULL;
+    }
+    // Separate consecutive strings
+    hash ^= 0xff;
+    hash *= 1099511628211ULL;
+  };
+
+  for ( const auto& opt : sim.control -> options )
+  {
+    if ( output_option( opt.name ) )
+    {
+      continue;
+    }
+
+    add( opt.scope );
+    add( opt.name );
+    add( opt.value );
+  }
+
+  // Actors are matched by index
+  for ( const auto p : sim.actor_list )
+  {
+    add( p -> name_str );
+  }
+
+  return hash;
+}
+
+// Plain data, stored as is
+template <typename T>
+struct raw_t
+{
+  static_assert( std::is_trivially_copyable<T>::value, "Only plain data can be stored as is" );
+
+  T& data;
+
+  void save( archive_t& ar ) const
+  { ar.write( std::string( reinterpret_cast<const char*>( &data ), sizeof( T ) ) ); }
+
+  void load( archive_t& ar )
+  {
+    std::string v;
+    ar.read( v );
+    if ( v.size() != sizeof( T ) )
+    {
+      throw std::runtime_error( "Invalid result data" );
+    }
+    std::memcpy( &data, v.data(), sizeof( T ) );
+  }
+};
+
+template <typename T>
+void raw( archive_t& ar, T& data )
+{
+  raw_t<T> r { data };
+  ar.merge( r );
+}
+
+// Vector of plain data
+template <typename T>
+struct raw_vector_t
+{
+  static_assert( std::is_trivially_copyable<T>::value, "Only plain data can be stored as is" );
+
+  std::vector<T>& data;
+
+  void save( archive_t& ar ) const
+  { ar.write( std::string( reinterpret_cast<const char*>( data.data() ), data.size() * sizeof( T ) ) ); }
+
+  void load( archive_t& ar )
+  {
+    std::string v;
+    ar.read( v );
+    if ( v.size() % sizeof( T ) != 0 )
+    {
+      throw std::runtime_error( "Invalid result data" );
+    }
+    data.resize( v.size() / sizeof( T ) );
+    std::memcpy( data.data(), v.data(), v.size() );
+  }
+};
+
+template <typename T>
+void raw_vector( archive_t& ar, std::vector<T>& data )
+{
+  raw_vector_t<T> r { data };
+  ar.merge( r );
+}
+
+// Sample sequence of an actor, resolved against the actors of the simulation
+struct action_sequence_archive_t
+{
+  player_collected_data_t::action_sequence_t& sequence;
+  const player_t* player;
+
+  void save( archive_t& ar ) const
+  { sequence.save( ar, player ); }
+
+  void load( archive_t& ar )
+  { sequence.load( ar, player ); }
+};
+
+// Scale factors of an ability
+struct stats_results_t
+{
+  stats_t* stats;
+
+  void serialize( archive_t& ar )
+  {
+    bool scaling = stats -> scaling != nullptr;
+    ar.state( scaling );
+    if ( scaling )
+    {
+      if ( ! stats -> scaling )
+      {
+        stats -> scaling = std::unique_ptr<stats_t::stats_scaling_t>( new stats_t::stats_scaling_t() );
+      }
+      raw( ar, *stats -> scaling );
+    }
+  }
+};
+
+// Results of an actor that are not part of its (checkpointed) collected data
+struct actor_results_t
+{
+  player_t* player;
+
+  void serialize( archive_t& ar )
+  {
+    auto& cd = player -> collected_data;
+
+    raw( ar, cd.buffed_stats_snapshot );
+
+    action_sequence_archive_t sequence { cd.action_sequence, player };
+    action_sequence_archive_t precombat { cd.action_sequence_precombat, player };
+    ar.merge( sequence );
+    ar.merge( precombat );
+
+    // Scale factors
+    bool scaling = player -> scaling != nullptr;
+    ar.state( scaling );
+    if ( scaling )
+    {
+      if ( ! player -> scaling )
+      {
+        throw std::runtime_error( "Scale factors saved for actor '" + player -> name_str + "' without scaling" );
+      }
+
+      auto& s = *player -> scaling;
+      raw( ar, s.scaling );
+      raw( ar, s.scaling_normalized );
+      raw( ar, s.scaling_error );
+      raw( ar, s.scaling_delta_dps );
+      raw( ar, s.scaling_compare_error );
+      raw( ar, s.scaling_lag );
+      raw( ar, s.scaling_lag_error );
+      raw( ar, s.scales_with );
+      raw( ar, s.over_cap );
+      ar.sequence( s.scaling_stats, []( archive_t& a, std::vector<stat_e>& stats ) { raw_vector( a, stats ); } );
+    }
+
+    std::vector<stats_results_t> stats;
+    for ( auto s : player -> stats_list )
+    {
+      stats.push_back( stats_results_t { s } );
+    }
+    ar.objects( stats, []( const stats_results_t& s ) { return s.stats -> name_str; },
+                [ &stats ]( const std::string& n ) -> stats_results_t* {
+                  auto it = range::find_if( stats, [ &n ]( const stats_results_t& s ) { return s.stats -> name_str == n; } );
+                  return it != stats.end() ? &( *it ) : nullptr;
+                } );
+
+    // Plots
+    ar.sequence( player -> dps_plot_data, []( archive_t& a, std::vector<plot_data_t>& d ) { raw_vector( a, d ); } );
+    uint64_t n_reforge = player -> reforge_plot_data.size();
+    ar.state( n_reforge );
+    player -> reforge_plot_data.resize( static_cast<size_t>( n_reforge ) );
+    ar.sequence( player -> reforge_plot_data, []( archive_t& a, std::vector<plot_data_t>& d ) { raw_vector( a, d ); } );
+  }
+};
+
+// Simulator level results
+void serialize_results( archive_t& ar, sim_t& sim )
+{
+  ar.state( sim.iterations );
+  ar.state( sim.elapsed_cpu );
+  ar.state( sim.elapsed_time );
+  ar.state( sim.init_time );
+  ar.state( sim.merge_time );
+  raw_vector( ar, sim.work_per_thread );
+  raw( ar, sim.scaling -> stats );
+
+  const auto& actors = sim.actor_list;
+  std::vector<actor_results_t> results;
+  for ( auto p : actors )
+  {
+    results.push_back( actor_results_t { p } );
+  }
+  ar.sequence( results, []( archive_t& a, actor_results_t& r ) { r.serialize( a ); } );
+
+  sim.profilesets.serialize( ar );
+}
+
+std::string read_file( const std::string& path )
+{
+  io::cfile file( path, "rb" );
+  if ( ! file )
+  {
+    throw std::runtime_error( "Unable to open result file '" + path + "'" );
+  }
+
+  std::string data;
+  std::array<char, 65536> buffer;
+  size_t n;
+  while ( ( n = fread( buffer.data(), 1, buffer.size(), file ) ) > 0 )
+  {
+    data.append( buffer.data(), n );
+  }
+
+  return data;
+}
+} // unnamed namespace
+
+// result_file_t::result_file_t =============================================
+
+result_file_t::result_file_t( sim_t& sim ) :
+  m_sim( sim )
+{ }
+
+// result_file_t::collect ===================================================
+
+void result_file_t::collect()
+{
+  m_archive = std::unique_ptr<archive_t>( new archive_t() );
+  m_archive -> write( RESULT_MAGIC );
+  m_archive -> write( RESULT_VERSION );
+
+  m_archive -> write( fingerprint( m_sim ) );
+
+  m_archive -> object( m_sim );
+}
+
+// result_file_t::save ======================================================
+
+void result_file_t::save()
+{
+  if ( ! m_archive )
+  {
+    return;
+  }
+
+  serialize_results( *m_archive, m_sim );
+
+  const std::string& data = m_archive -> data();
+  io::cfile file( m_sim.save_results_file_str, "wb" );
+  if ( ! file || fwrite( data.data(), 1, data.size(), file ) != data.size() )
+  {
+    m_sim.errorf( "Unable to write result file '%s'", m_sim.save_results_file_str.c_str() );
+  }
+
+  m_archive.reset();
+}
+
+// result_file_t::load ======================================================
+
+bool result_file_t::load( sim_t& sim )
+{
+  if ( ! sim.init() )
+  {
+    return false;
+  }
+
+  try
+  {
+    archive_t ar( read_file( sim.load_results_file_str ) );
+    if ( ar.data().size() < 2 * sizeof( uint32_t ) || ar.read<uint32_t>() != RESULT_MAGIC ||
+         ar.read<uint32_t>() != RESULT_VERSION )
+    {
+      throw std::runtime_error( "'" + sim.load_results_file_str +
+                                "' is not a result file of this version of the simulator" );
+    }
+
+    if ( ar.read<uint64_t>() != fingerprint( sim ) )
+    {
+      throw std::runtime_error( "Result file '" + sim.load_results_file_str +
+                                "' was saved by a simulation of different options or actors" );
+    }
+
+    ar.object( sim );
+    serialize_results( ar, sim );
+  }
+  catch ( const std::exception& e )
+  {
+    sim.errorf( "Unable to load results: %s", e.what() );
+    return false;
+  }
+
+  sim.analyze();
+
+  return true;
+}
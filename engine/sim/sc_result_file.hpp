@@ -0,0 +1,53 @@
+// ==========================================================================
+// Dedmonwakeen's Raid DPS/TPS Simulator.
+// Send questions to natehieter@gmail.com
+// ==========================================================================
+#ifndef SC_RESULT_FILE_HH
+#define SC_RESULT_FILE_HH
+
+#include <memory>
+#include <string>
+
+#include "util/generic.hpp"
+#include "util/archive.hpp"
+
+struct sim_t;
+
+// Simulation result files ==================================================
+//
+// With save_results=<file>, the results of the simulation are saved in a binary file once the
+// simulation is done: the collected data of the simulator and its actors (as merged from all
+// threads, before it is analyzed), sample sequences, scale factors, plot data and profileset
+// results. With load_results=<file>, the simulator reports the saved results instead of
+// simulating. The simulator is initialized from the same profile, the saved results are loaded
+// into the initialized actors and analyzed, and the reports are generated with the report
+// options of the current run (e.g., html=, json2=, report_details=). Loading skips the simulation
+// only, it still initializes the simulator in full.
+//
+// The result file stores a hash of the simulation options, except the options of the output and
+// the execution (e.g., reports, threads, iterations), and of the actor names. Results are only
+// loaded by a simulation of the same hash.
+
+struct result_file_t : private noncopyable
+{
+private:
+  sim_t& m_sim;
+  // Collected data of the main simulation, serialized before it is analyzed
+  std::unique_ptr<archive_t> m_archive;
+
+public:
+  result_file_t( sim_t& sim );
+
+  // Serialize the collected data of the main simulation, called once the simulator threads are
+  // merged
+  void collect();
+
+  // Save the result file, called once scaling, plotting and profilesets are done
+  void save();
+
+  // Load and analyze the results of a result file into an uninitialized simulator. Returns false
+  // if the results could not be loaded.
+  static bool load( sim_t& sim );
+};
+
+#endif // SC_RESULT_FILE_HH
@@ -45,6 +45,59 @@ bool stat_may_cap( int stat )
   return false;
 }
 
+// paired_error =============================================================
+
+// Error of the difference of two metrics, computed from the per-iteration differences of
+// simulations using common random numbers. Returns a negative value if the iterations of the
+// simulations can not be paired.
+//
+// Only scale factors report the error of a difference. Plot points report the error of their own
+// mean, and profileset results keep no per-iteration samples to pair with the baseline, so neither
+// uses the paired error.
+double paired_error( const sim_t* sim, const scaling_metric_data_t& delta, const scaling_metric_data_t& ref )
+{
+  if ( ! sim -> common_random_numbers || ! delta.samples || ! ref.samples )
+    return -1;
+
+  const std::vector<double>& delta_data = delta.samples -> data();
+  const std::vector<double>& ref_data = ref.samples -> data();
+  size_t n = delta_data.size();
+  if ( n < 2 || ref_data.size() != n )
+    return -1;
+
+  double mean = 0;
+  for ( size_t i = 0; i < n; ++i )
+    mean += delta_data[ i ] - ref_data[ i ];
+  mean /= n;
+
+  double variance = 0;
+  for ( size_t i = 0; i < n; ++i )
+  {
+    double d = delta_data[ i ] - ref_data[ i ] - mean;
+    variance += d * d;
+  }
+  variance /= n - 1;
+
+  return sqrt( variance / n ) * sim -> confidence_estimator;
+}
+
+// regression_stat ==========================================================
+
+// Stats that can be perturbed per iteration. Weapon damage is not part of the stats of an actor, and
+// stamina determines resources that are only computed on initialization.
+bool regression_stat( stat_e stat )
+{
+  switch ( stat )
+  {
+    case STAT_STAMINA:
+    case STAT_WEAPON_DPS:
+    case STAT_WEAPON_OFFHAND_DPS:
+      return false;
+    default:
+      return true;
+  }
+}
+
 // parse_normalize_scale_factors ============================================
 
 bool parse_normalize_scale_factors( sim_t* sim,
@@ -114,7 +167,8 @@ scaling_t::scaling_t( sim_t* s ) :
   current_scaling_stat( STAT_NONE ),
   num_scaling_stats( 0 ),
   remaining_scaling_stats( 0 ),
-  scale_over(), scaling_metric( SCALE_METRIC_DPS ), scale_over_player()
+  scale_over(), scaling_metric( SCALE_METRIC_DPS ), scale_over_player(),
+  scale_regression( 0 )
 {
   create_options();
 }
@@ -217,6 +271,11 @@ void scaling_t::analyze_stats()
   baseline_sim = sim; // Take the current sim as baseline
   mutex.unlock();
 
+  if ( scale_regression )
+  {
+    stats_to_scale = analyze_stats_regression( stats_to_scale );
+  }
+
   for ( size_t k = 0; k < stats_to_scale.size(); ++k )
   {
     if ( sim -> is_canceled() ) break;
@@ -290,6 +349,10 @@ void scaling_t::analyze_stats()
         if ( error > 0 )
           error = sqrt( error );
 
+        double pair_error = paired_error( sim, delta_p -> scaling_for_metric( sm ), ref_p -> scaling_for_metric( sm ) );
+        if ( pair_error >= 0 )
+          error = pair_error;
+
         error = fabs( error / divisor );
 
         if ( fabs( divisor ) < 1.0 ) // For things like Weapon Speed, show the gain per 0.1 speed gain rather than every 1.0.
@@ -335,6 +398,147 @@ void scaling_t::analyze_stats()
   baseline_sim = nullptr;
 }
 
+// scaling_t::analyze_stats_regression ======================================
+
+// Estimate the scale factors of all stats that can be perturbed per iteration with one simulation.
+// Each iteration adds +/- the scale delta of every stat at random, and the scale factors are the
+// coefficients of a least squares fit of the per-iteration metric against the perturbations.
+// Returns the stats that need to be scaled separately.
+std::vector<stat_e> scaling_t::analyze_stats_regression( const std::vector<stat_e>& stats_to_scale )
+{
+  std::vector<stat_e> regression_stats, other_stats;
+  for ( stat_e stat : stats_to_scale )
+  {
+    if ( regression_stat( stat ) )
+      regression_stats.push_back( stat );
+    else
+      other_stats.push_back( stat );
+  }
+
+  // Metric samples of single actor batch simulations are not collected on every iteration
+  if ( regression_stats.empty() || sim -> single_actor_batch )
+  {
+    return stats_to_scale;
+  }
+
+  mutex.lock();
+  ref_sim = baseline_sim;
+  delta_sim = new sim_t( sim );
+  current_scaling_stat = regression_stats.front();
+  mutex.unlock();
+
+  delta_sim -> progress_bar.set_base( "Regression" );
+  delta_sim -> scaling -> scale_stat = STAT_MAX;
+  delta_sim -> scaling -> perturbed_stats = regression_stats;
+  for ( stat_e stat : regression_stats )
+  {
+    delta_sim -> scaling -> perturbation_deltas.push_back( stats.get_stat( stat ) );
+  }
+  delta_sim -> execute();
+
+  // Regressors of each iteration: an intercept, and the perturbation of each stat
+  const std::vector<double>& perturbations = delta_sim -> scaling -> perturbations;
+  size_t k = regression_stats.size();
+  size_t n = perturbations.size() / k;
+  std::vector<double> x, weights( n, 1.0 );
+  for ( size_t i = 0; i < n; ++i )
+  {
+    x.push_back( 1.0 );
+    x.insert( x.end(), perturbations.begin() + i * k, perturbations.begin() + ( i + 1 ) * k );
+  }
+
+  for ( size_t j = 0; j < sim -> players_by_name.size() && ! sim -> is_canceled(); j++ )
+  {
+    player_t* p = sim -> players_by_name[ j ];
+    player_t* delta_p = delta_sim -> find_player( p -> name() );
+    assert( delta_p && "Delta player not found" );
+
+    for ( scale_metric_e sm = SCALE_METRIC_NONE; sm < SCALE_METRIC_MAX; sm++ )
+    {
+      scaling_metric_data_t data = delta_p -> scaling_for_metric( sm );
+      std::vector<double> coefficients, inverse;
+      double variance;
+      if ( ! data.samples || data.samples -> data().size() != n ||
+           ! statistics::least_squares( x, data.samples -> data(), weights, k + 1, coefficients, inverse, variance ) )
+      {
+        continue;
+      }
+
+      for ( size_t i = 0; i < k; ++i )
+      {
+        stat_e stat = regression_stats[ i ];
+        if ( ! p -> scaling -> scales_with[ stat ] ) continue;
+
+        double score = delta_p -> invert_scaling ? -coefficients[ i + 1 ] : coefficients[ i + 1 ];
+        double error = sqrt( variance * inverse[ ( i + 1 ) * ( k + 1 ) + i + 1 ] ) * delta_sim -> confidence_estimator;
+
+        p -> scaling -> scaling[ sm ].set_stat( stat, score );
+        p -> scaling -> scaling_error[ sm ].set_stat( stat, error );
+        p -> scaling -> scaling_compare_error[ sm ].set_stat( stat, error );
+      }
+    }
+  }
+
+  if ( debug_scale_factors )
+  {
+    std::cout << "\nregression delta_sim report..." << std::endl;
+    report::print_text( delta_sim, true );
+  }
+
+  mutex.lock();
+  delete delta_sim;
+  delta_sim = nullptr;
+  ref_sim = nullptr;
+  remaining_scaling_stats -= as<int>( regression_stats.size() );
+  mutex.unlock();
+
+  return other_stats;
+}
+
+// scaling_t::reset =========================================================
+
+// Draw the stat perturbation of a regression simulation for the next iteration
+void scaling_t::reset()
+{
+  if ( perturbed_stats.empty() )
+    return;
+
+  perturbation.resize( perturbed_stats.size() );
+  for ( size_t i = 0; i < perturbed_stats.size(); ++i )
+  {
+    perturbation[ i ] = sim -> rng().roll( 0.5 ) ? perturbation_deltas[ i ] : -perturbation_deltas[ i ];
+  }
+}
+
+// scaling_t::perturb =======================================================
+
+// Apply the stat perturbation of the iteration to a reset actor
+void scaling_t::perturb( player_t* p ) const
+{
+  if ( perturbation.empty() || ! p -> scale_player || p -> is_pet() || p -> is_enemy() )
+    return;
+
+  for ( size_t i = 0; i < perturbed_stats.size(); ++i )
+  {
+    p -> current.stats.add_stat( perturbed_stats[ i ], perturbation[ i ] );
+  }
+  p -> cache.invalidate_all();
+}
+
+// scaling_t::datacollection_end ============================================
+
+void scaling_t::datacollection_end()
+{
+  range::append( perturbations, perturbation );
+}
+
+// scaling_t::merge =========================================================
+
+void scaling_t::merge( const scaling_t& other )
+{
+  range::append( perturbations, other.perturbations );
+}
+
 /* Creates scale factors for stats_t objects
  *
  */
@@ -411,6 +615,10 @@ void scaling_t::analyze_lag()
       double ref_error = ref_p -> scaling_for_metric( sm ).stddev * ref_sim -> confidence_estimator;
       double error = sqrt( delta_error * delta_error + ref_error * ref_error );
 
+      double pair_error = paired_error( sim, delta_p -> scaling_for_metric( sm ), ref_p -> scaling_for_metric( sm ) );
+      if ( pair_error >= 0 )
+        error = pair_error;
+
       double score = ( delta_score - ref_score ) / divisor;
 
       error = fabs( error / divisor );
@@ -521,6 +729,7 @@ void scaling_t::create_options()
   sim->add_option(opt_string("scale_only", scale_only_str));
   sim->add_option(opt_string("scale_over", scale_over));
   sim->add_option(opt_string("scale_over_player", scale_over_player));
+  sim->add_option(opt_bool("scale_regression", scale_regression));
 }
 
 // scaling_t::has_scale_factors =============================================
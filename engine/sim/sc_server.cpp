@@ -0,0 +1,459 @@
+// ==========================================================================
+// Dedmonwakeen's Raid DPS/TPS Simulator.
+// Send questions to natehieter@gmail.com
+// ==========================================================================
+
+// Simulation server
+//
+// Accepts simulation jobs over a framed stream protocol, either on standard input/output
+// (server=stdio), or on a local UNIX domain socket (server=unix:<path>). Requests are a single
+// header line, optionally followed by a payload:
+//
+//   run <id> <length>\n<length bytes of simc option text>
+//   cancel <id>\n
+//   quit\n       (close the session, outstanding jobs are still reported on stdio)
+//   shutdown\n   (stop the server)
+//
+// Each finished job is answered with a header line followed by the payload:
+//
+//   <done|failed|canceled> <id> <length>\n<length bytes of JSON v2 report, or error message>
+//
+// Protocol level problems are answered with "error <id> <length>\n<message>", where id is "-" if
+// the request could not be associated with a job.
+//
+// Job ids are scoped to the session: simultaneous sessions may use the same ids, and a session can
+// only cancel its own jobs. Job options are limited to MAX_PAYLOAD bytes, larger requests are
+// answered with an error.
+
+#include "simulationcraft.hpp"
+#include "sc_job.hpp"
+
+#include <list>
+
+#if defined( SC_WINDOWS )
+#include <io.h>
+#include <fcntl.h>
+#else
+#include <csignal>
+#include <cerrno>
+#include <unistd.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#endif
+
+namespace job
+{
+namespace server
+{
+namespace
+{
+const size_t MAX_PAYLOAD = 64 * 1024 * 1024;
+
+// A bidirectional stream of requests and responses. Responses may be written from any worker
+// thread.
+class channel_t : private noncopyable
+{
+  io::cfile  m_in;
+  io::cfile  m_out;
+  std::mutex m_write_mutex;
+
+public:
+  channel_t( io::cfile in, io::cfile out ) : m_in( in ), m_out( out )
+  { }
+
+  bool read_line( std::string& line )
+  {
+    line.clear();
+
+    std::array<char, 256> buffer;
+    while ( fgets( buffer.data(), static_cast<int>( buffer.size() ), m_in ) )
+    {
+      line += buffer.data();
+      if ( ! line.empty() && line.back() == '\n' )
+      {
+        break;
+      }
+    }
+
+    while ( ! line.empty() && ( line.back() == '\n' || line.back() == '\r' ) )
+    {
+      line.pop_back();
+    }
+
+    return ! line.empty() || ( ! feof( m_in ) && ! ferror( m_in ) );
+  }
+
+  bool read( std::string& data, size_t length )
+  {
+    data.assign( length, '\0' );
+
+    return length == 0 || fread( &data[ 0 ], 1, length, m_in ) == length;
+  }
+
+  // Discard the payload of a rejected request, so that the next request can be read
+  bool skip( size_t length )
+  {
+    std::array<char, 65536> buffer;
+    while ( length > 0 )
+    {
+      size_t n = std::min( length, buffer.size() );
+      if ( fread( buffer.data(), 1, n, m_in ) != n )
+      {
+        return false;
+      }
+      length -= n;
+    }
+
+    return true;
+  }
+
+  void respond( const std::string& status, const std::string& id, const std::string& payload )
+  {
+    std::lock_guard<std::mutex> lock( m_write_mutex );
+
+    fprintf( m_out, "%s %s %u\n", status.c_str(), id.c_str(), as<unsigned>( payload.size() ) );
+    fwrite( payload.data(), 1, payload.size(), m_out );
+    fflush( m_out );
+  }
+
+  // Unblock a pending read, used to tear down sessions when the server stops
+  void close_input()
+  {
+#if ! defined( SC_WINDOWS )
+    ::shutdown( fileno( m_in ), SHUT_RD );
+#endif
+  }
+};
+
+class service_t : private noncopyable
+{
+  const option_db_t&    m_base;
+  pool_t                m_pool;
+  std::atomic<bool>     m_stopping;
+  std::atomic<unsigned> m_sessions;
+
+public:
+  service_t( const option_db_t& base, const budget_t& budget ) :
+    m_base( base ), m_pool( budget.jobs, budget.sim_threads ), m_stopping( false ), m_sessions( 0 )
+  { }
+
+  bool stopping() const
+  { return m_stopping; }
+
+  void stop()
+  { m_stopping = true; }
+
+  pool_t& pool()
+  { return m_pool; }
+
+  // Serve a single session, returns when the session ends (quit, shutdown, or end of stream).
+  // Jobs still unfinished at the end of the session are optionally canceled.
+  void session( const std::shared_ptr<channel_t>& channel, bool cancel_on_close );
+
+private:
+  void run_request( const std::shared_ptr<channel_t>& channel, const std::string& scope,
+                    const std::vector<std::string>& args, std::vector<std::weak_ptr<job_t>>& submitted );
+};
+
+void service_t::run_request( const std::shared_ptr<channel_t>& channel, const std::string& scope,
+                             const std::vector<std::string>& args, std::vector<std::weak_ptr<job_t>>& submitted )
+{
+  const auto& id = args[ 1 ];
+  size_t length = util::to_unsigned( args[ 2 ] );
+  std::string text;
+
+  if ( length > MAX_PAYLOAD )
+  {
+    channel -> respond( "error", id, "Job options exceed " + util::to_string( MAX_PAYLOAD ) + " bytes" );
+    if ( ! channel -> skip( length ) )
+    {
+      channel -> respond( "error", id, "Truncated job options" );
+    }
+    return;
+  }
+
+  try
+  {
+    if ( ! channel -> read( text, length ) )
+    {
+      channel -> respond( "error", id, "Truncated job options" );
+      return;
+    }
+  }
+  catch ( const std::bad_alloc& )
+  {
+    channel -> respond( "error", id, "Out of memory reading job options" );
+    channel -> skip( length );
+    return;
+  }
+
+  // Job options are parsed on top of the base options given on the command line, so that each job
+  // can override them
+  option_db_t options( m_base );
+  try
+  {
+    options.parse_text( text );
+  }
+  catch ( const std::exception& e )
+  {
+    channel -> respond( "error", id, e.what() );
+    return;
+  }
+
+  // The pool knows the job by its session scoped name, the client by its id
+  auto job = std::make_shared<job_t>( scope + id, options, REPORT_JSON );
+  job -> on_finish = [ channel, id ]( job_t& j ) {
+    channel -> respond( job_state_string( j.state() ), id, j.result() );
+  };
+
+  try
+  {
+    m_pool.submit( job );
+
+    // The pool drops finished jobs, forget them along with their names
+    submitted.erase( std::remove_if( submitted.begin(), submitted.end(),
+                                     []( const std::weak_ptr<job_t>& j ) { return j.expired(); } ),
+                     submitted.end() );
+    submitted.push_back( job );
+  }
+  catch ( const std::exception& )
+  {
+    channel -> respond( "error", id, "Job '" + id + "' already exists" );
+  }
+}
+
+void service_t::session( const std::shared_ptr<channel_t>& channel, bool cancel_on_close )
+{
+  std::string scope = util::to_string( ++m_sessions ) + ":";
+  std::vector<std::weak_ptr<job_t>> submitted;
+  std::string line;
+
+  while ( ! stopping() && channel -> read_line( line ) )
+  {
+    auto args = util::string_split( line, " \t" );
+    if ( args.empty() )
+    {
+      continue;
+    }
+
+    if ( args[ 0 ] == "run" && args.size() == 3 )
+    {
+      run_request( channel, scope, args, submitted );
+    }
+    else if ( args[ 0 ] == "cancel" && args.size() == 2 )
+    {
+      if ( ! m_pool.cancel( scope + args[ 1 ] ) )
+      {
+        channel -> respond( "error", args[ 1 ], "No such job" );
+      }
+    }
+    else if ( args[ 0 ] == "quit" && args.size() == 1 )
+    {
+      break;
+    }
+    else if ( args[ 0 ] == "shutdown" && args.size() == 1 )
+    {
+      stop();
+      break;
+    }
+    else
+    {
+      channel -> respond( "error", "-", "Invalid request '" + line + "'" );
+    }
+  }
+
+  // Nobody is listening to the results anymore, canceling finished jobs is a no-op
+  if ( cancel_on_close )
+  {
+    range::for_each( submitted, [ this ]( const std::weak_ptr<job_t>& j ) {
+      if ( auto job = j.lock() )
+      {
+        m_pool.cancel( job -> name() );
+      }
+    } );
+  }
+}
+
+// Serve a single session over the standard input and output of the process
+int serve_stdio( service_t& service )
+{
+  // Reserve the real standard output for the protocol, and redirect everything else the simulator
+  // prints (progress, text reports, timers) to standard error
+  fflush( stdout );
+#if defined( SC_WINDOWS )
+  int protocol_fd = _dup( _fileno( stdout ) );
+  _dup2( _fileno( stderr ), _fileno( stdout ) );
+  _setmode( protocol_fd, _O_BINARY );
+  _setmode( _fileno( stdin ), _O_BINARY );
+  io::cfile out( _fdopen( protocol_fd, "wb" ) );
+#else
+  int protocol_fd = dup( fileno( stdout ) );
+  dup2( fileno( stderr ), fileno( stdout ) );
+  io::cfile out( fdopen( protocol_fd, "wb" ) );
+#endif
+
+  if ( ! out )
+  {
+    std::cerr << "ERROR! Unable to open server output stream" << std::endl;
+    return 1;
+  }
+
+  auto channel = std::make_shared<channel_t>( io::cfile( stdin, io::cfile::no_close() ), out );
+
+  service.session( channel, false );
+
+  if ( service.stopping() )
+  {
+    service.pool().cancel();
+  }
+
+  // Report all outstanding work before exiting
+  service.pool().wait();
+
+  return 0;
+}
+
+#if ! defined( SC_WINDOWS )
+// Serve any number of simultaneous sessions over a local UNIX domain socket
+int serve_unix( service_t& service, const std::string& path )
+{
+  sockaddr_un address;
+  if ( path.empty() || path.size() >= sizeof( address.sun_path ) )
+  {
+    std::cerr << "ERROR! Invalid server socket path '" << path << "'" << std::endl;
+    return 1;
+  }
+
+  int listen_fd = socket( AF_UNIX, SOCK_STREAM, 0 );
+  if ( listen_fd < 0 )
+  {
+    perror( "Unable to create server socket" );
+    return 1;
+  }
+
+  memset( &address, 0, sizeof( address ) );
+  address.sun_family = AF_UNIX;
+  strncpy( address.sun_path, path.c_str(), sizeof( address.sun_path ) - 1 );
+
+  unlink( path.c_str() );
+  if ( bind( listen_fd, reinterpret_cast<sockaddr*>( &address ), sizeof( address ) ) != 0 ||
+       listen( listen_fd, 16 ) != 0 )
+  {
+    perror( "Unable to listen on server socket" );
+    close( listen_fd );
+    return 1;
+  }
+
+  // Clients disconnecting before their results are written must not take the server down
+  signal( SIGPIPE, SIG_IGN );
+
+  std::cerr << "Simulation server listening on " << path << std::endl;
+
+  // Sessions are reaped when the next client connects, releasing their thread and their channel
+  // (once the jobs of the session have reported)
+  struct session_t
+  {
+    std::shared_ptr<channel_t> channel;
+    std::thread thread;
+    std::atomic<bool> done;
+
+    session_t( const std::shared_ptr<channel_t>& c ) : channel( c ), done( false )
+    { }
+  };
+
+  std::mutex session_mutex;
+  std::list<session_t> sessions;
+
+  while ( ! service.stopping() )
+  {
+    int fd = accept( listen_fd, nullptr, nullptr );
+    if ( fd < 0 )
+    {
+      if ( errno == EINTR )
+      {
+        continue;
+      }
+      break;
+    }
+
+    auto channel = std::make_shared<channel_t>( io::cfile( fdopen( fd, "rb" ) ),
+                                                io::cfile( fdopen( dup( fd ), "wb" ) ) );
+
+    std::lock_guard<std::mutex> lock( session_mutex );
+
+    for ( auto it = sessions.begin(); it != sessions.end(); )
+    {
+      if ( it -> done )
+      {
+        it -> thread.join();
+        it = sessions.erase( it );
+      }
+      else
+      {
+        ++it;
+      }
+    }
+
+    sessions.emplace_back( channel );
+    session_t& session = sessions.back();
+    session.thread = std::thread( [ &service, &session, listen_fd ]() {
+      service.session( session.channel, true );
+      session.done = true;
+      // A shutdown request wakes up the (blocking) accept loop
+      if ( service.stopping() )
+      {
+        ::shutdown( listen_fd, SHUT_RDWR );
+      }
+    } );
+  }
+
+  {
+    std::lock_guard<std::mutex> lock( session_mutex );
+    range::for_each( sessions, []( session_t& s ) { s.channel -> close_input(); } );
+  }
+
+  range::for_each( sessions, []( session_t& s ) { s.thread.join(); } );
+  sessions.clear();
+
+  service.pool().cancel();
+  service.pool().wait();
+
+  close( listen_fd );
+  unlink( path.c_str() );
+
+  return 0;
+}
+#endif
+} // unnamed namespace
+
+// serve ====================================================================
+
+int serve( const std::string& endpoint, const option_db_t& base, const budget_t& budget )
+{
+  std::cerr << "Starting simulation server (" << budget.jobs << " simultaneous jobs, "
+            << budget.sim_threads << " threads per job)" << std::endl;
+
+  service_t service( base, budget );
+
+  if ( util::str_compare_ci( endpoint, "stdio" ) )
+  {
+    return serve_stdio( service );
+  }
+
+  if ( endpoint.compare( 0, 5, "unix:" ) == 0 )
+  {
+#if ! defined( SC_WINDOWS )
+    return serve_unix( service, endpoint.substr( 5 ) );
+#else
+    std::cerr << "ERROR! UNIX socket server endpoints are not supported on this platform" << std::endl;
+    return 1;
+#endif
+  }
+
+  std::cerr << "ERROR! Unknown server endpoint '" << endpoint
+            << "', expected 'stdio' or 'unix:<path>'" << std::endl;
+  return 1;
+}
+
+} // Namespace server ends
+} // Namespace job ends
@@ -6,6 +6,13 @@
 #include "simulationcraft.hpp"
 #include "report/sc_highchart.hpp"
 #include "sc_profileset.hpp"
+#include "sc_checkpoint.hpp"
+#include "sc_health_calibration.hpp"
+#include "sc_result_file.hpp"
+#include <thread>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
 #ifdef SC_WINDOWS
 #include <direct.h>
 #endif
@@ -1321,6 +1328,123 @@ struct compare_name
 // Simulator
 // ==========================================================================
 
+// sim_t::merge_pool_t ======================================================
+
+/**
+ * @brief Simulator threads waiting for the results of all threads to be merged
+ *
+ * Simulator threads wait here when they are done with iterating and merging their part of the
+ * results, until the main thread has merged all results. Meanwhile they merge actors of any merge
+ * in progress, so actors are merged in parallel without additional threads.
+ */
+struct sim_t::merge_pool_t
+{
+  // Indices 0 .. n - 1 to process, claimed by the merging thread and the helping threads
+  struct work_t
+  {
+    size_t n;
+    std::function<void(size_t)> fn;
+    std::atomic<size_t> next;
+    int helpers;
+
+    work_t( size_t n_, std::function<void(size_t)> fn_ ) :
+      n( n_ ), fn( std::move( fn_ ) ), next( 0 ), helpers( 0 )
+    { }
+
+    bool available() const
+    { return next < n; }
+
+    void process()
+    {
+      size_t i;
+      while ( ( i = next++ ) < n )
+      {
+        fn( i );
+      }
+    }
+  };
+
+  std::mutex mutex;
+  std::condition_variable cv;
+  std::vector<bool> finished;
+  std::vector<work_t*> work;
+  bool done;
+
+  merge_pool_t( int n_threads ) :
+    finished( n_threads, false ), done( false )
+  { }
+
+  // Simulator thread is done with iterating and merging
+  void finish( int thread_index )
+  {
+    {
+      std::lock_guard<std::mutex> lock( mutex );
+      finished[ thread_index ] = true;
+    }
+    cv.notify_all();
+  }
+
+  void wait( int thread_index )
+  {
+    std::unique_lock<std::mutex> lock( mutex );
+    cv.wait( lock, [ this, thread_index ] { return finished[ thread_index ]; } );
+  }
+
+  // Call fn( i ) for i in 0 .. n - 1 on the calling thread and the waiting threads
+  void run( size_t n, std::function<void(size_t)> fn )
+  {
+    work_t w( n, std::move( fn ) );
+    {
+      std::lock_guard<std::mutex> lock( mutex );
+      work.push_back( &w );
+    }
+    cv.notify_all();
+
+    w.process();
+
+    // All indices are claimed, wait for the helpers to finish theirs
+    std::unique_lock<std::mutex> lock( mutex );
+    work.erase( range::find( work, &w ) );
+    cv.wait( lock, [ &w ] { return w.helpers == 0; } );
+  }
+
+  // Help with merges in progress until stop() is called
+  void help()
+  {
+    std::unique_lock<std::mutex> lock( mutex );
+    while ( true )
+    {
+      work_t* w = nullptr;
+      cv.wait( lock, [ this, &w ] {
+        auto it = range::find_if( work, []( const work_t* w ) { return w -> available(); } );
+        w = it != work.end() ? *it : nullptr;
+        return w || done;
+      } );
+
+      if ( ! w )
+      {
+        return;
+      }
+
+      w -> helpers++;
+      lock.unlock();
+      w -> process();
+      lock.lock();
+      w -> helpers--;
+      cv.notify_all();
+    }
+  }
+
+  void stop()
+  {
+    {
+      std::lock_guard<std::mutex> lock( mutex );
+      done = true;
+    }
+    cv.notify_all();
+  }
+};
+
 // sim_t::sim_t =============================================================
 
 sim_t::sim_t( sim_t* p, int index ) :
@@ -1332,6 +1456,9 @@ sim_t::sim_t( sim_t* p, int index ) :
   max_time( timespan_t::zero() ),
   expected_iteration_time( timespan_t::zero() ),
   vary_combat_length( 0.0 ),
+  antithetic_combat_length( false ),
+  paired_combat_length( 0.0 ),
+  control_variates( false ),
   current_iteration( -1 ),
   iterations( 0 ),
   canceled( 0 ),
@@ -1368,7 +1495,7 @@ sim_t::sim_t( sim_t* p, int index ) :
   travel_variance( 0 ), default_skill( 1.0 ), reaction_time( timespan_t::from_seconds( 0.5 ) ),
   regen_periodicity( timespan_t::from_seconds( 0.25 ) ),
   ignite_sampling_delta( timespan_t::from_seconds( 0.2 ) ),
-  fixed_time( false ), optimize_expressions( false ),
+  fixed_time( false ), optimize_expressions( false ), batch_dot_ticks( false ), stats_accumulator( false ),
   current_slot( -1 ),
   optimal_raid( 0 ), log( 0 ), debug_each( 0 ), save_profiles( 0 ), default_actions( 0 ),
   normalized_stat( STAT_NONE ),
@@ -1379,6 +1506,7 @@ sim_t::sim_t( sim_t* p, int index ) :
   auto_ready_trigger( 0 ), stat_cache( 1 ), max_aoe_enemies( 20 ), show_etmi( 0 ), tmi_window_global( 0 ), tmi_bin_size( 0.5 ),
   requires_regen_event( false ), single_actor_batch( false ),
   progressbar_type( 0 ),
+  progressbar_thread( false ),
   armory_retries( 3 ),
   enemy_death_pct( 0 ), rel_target_level( -1 ), target_level( -1 ),
   target_adds( 0 ), desired_targets( 1 ), enable_taunts( false ),
@@ -1387,9 +1515,12 @@ sim_t::sim_t( sim_t* p, int index ) :
   disable_set_bonuses( false ), disable_2_set( 1 ), disable_4_set( 1 ), enable_2_set( 1 ), enable_4_set( 1 ),
   pvp_crit( false ),
   active_enemies( 0 ), active_allies( 0 ),
-  _rng(), seed( 0 ), deterministic( 0 ), strict_work_queue( 0 ),
+  _rng(), _raid_event_rng(), seed( 0 ), deterministic( 0 ), strict_work_queue( 0 ), common_random_numbers( 0 ),
   average_range( true ), average_gauss( false ),
   convergence_scale( 2 ),
+  checkpoint_interval( 60.0 ), checkpoint_resume( 0 ),
+  enemy_health_calibration( 0 ), enemy_health_calibration_tolerance( 1.0 ),
+  health_calibration( new health_calibration_t() ),
   fight_style( "Patchwerk" ), add_waves( 0 ), overrides( overrides_t() ),
   default_aura_delay( timespan_t::from_millis( 30 ) ),
   default_aura_delay_stddev( timespan_t::from_millis( 5 ) ),
@@ -1400,6 +1531,7 @@ sim_t::sim_t( sim_t* p, int index ) :
   elapsed_cpu( 0.0 ),
   elapsed_time( 0.0 ),
   work_done( 0 ),
+  progress_work( 0 ),
   iteration_dmg( 0 ), priority_iteration_dmg( 0 ), iteration_heal( 0 ), iteration_absorb( 0 ),
   raid_dps(), total_dmg(), raid_hps(), total_heal(), total_absorb(), raid_aps(),
   simulation_length( "Simulation Length", false ),
@@ -1425,7 +1557,7 @@ sim_t::sim_t( sim_t* p, int index ) :
   enable_dps_healing( false ),
   scaling_normalized( 1.0 ),
   // Multi-Threading
-  threads( 0 ), thread_index( index ), process_priority( computer_process::BELOW_NORMAL ),
+  threads( 0 ), parallel_actor_init( false ), thread_index( index ), process_priority( computer_process::BELOW_NORMAL ),
   work_queue( new work_queue_t() ),
   spell_query(), spell_query_level( MAX_LEVEL ),
   pause_mutex( nullptr ),
@@ -1459,6 +1591,8 @@ sim_t::sim_t( sim_t* p, int index ) :
     assert( parent -> scaling );
     scaling -> scale_stat  = parent -> scaling -> scale_stat;
     scaling -> scale_value = parent -> scaling -> scale_value;
+    scaling -> perturbed_stats = parent -> scaling -> perturbed_stats;
+    scaling -> perturbation_deltas = parent -> scaling -> perturbation_deltas;
 
     // Inherit reporting directives from parent
     report_progress = parent -> report_progress;
@@ -1469,6 +1603,8 @@ sim_t::sim_t( sim_t* p, int index ) :
     // While we inherit the parent seed, it may get overwritten in sim_t::init
     seed = parent -> seed;
 
+    health_calibration -> inherit( *parent -> health_calibration );
+
     parent -> add_relative( this );
   }
 }
@@ -1492,10 +1628,29 @@ double sim_t::iteration_time_adjust() const
   if ( current_iteration == 0 )
     return 1.0;
 
+  // Even iterations mirror the combat length of the preceding odd iteration
+  if ( antithetic_combat_length && current_iteration % 2 == 0 )
+  {
+    return 1.0 - paired_combat_length;
+  }
+
   auto progress = work_queue -> progress();
   return 1.0 + vary_combat_length * ( ( current_iteration % 2 ) ? 1 : -1 ) * progress.pct();
 }
 
+// sim_t::iteration_seed ====================================================
+
+// Seed of the current iteration with common_random_numbers=1, only depends on the simulation seed,
+// the thread and the iteration number of the thread (SplitMix64 finalizer).
+uint64_t sim_t::iteration_seed() const
+{
+  uint64_t z = seed + ( static_cast<uint64_t>( thread_index ) << 32 ) +
+               static_cast<uint64_t>( current_iteration ) * 0x9e3779b97f4a7c15ULL;
+  z = ( z ^ ( z >> 30 ) ) * 0xbf58476d1ce4e5b9ULL;
+  z = ( z ^ ( z >> 27 ) ) * 0x94d049bb133111ebULL;
+  return z ^ ( z >> 31 );
+}
+
 // sim_t::expected_max_time =================================================
 
 double sim_t::expected_max_time() const
@@ -1614,12 +1769,25 @@ void sim_t::reset()
   if ( debug )
     out_debug << "Resetting Simulator";
 
-  if( deterministic )
+  if ( common_random_numbers )
+  {
+    uint64_t s = iteration_seed();
+    rng().seed( s );
+    rng().reset();
+    raid_event_rng().seed( s ^ 0x5241494445564e54ULL ); // "RAIDEVNT"
+    raid_event_rng().reset();
+  }
+  else if( deterministic )
     seed = rng().reseed();
 
   event_mgr.reset();
 
-  expected_iteration_time = max_time * iteration_time_adjust();
+  double time_adjust = iteration_time_adjust();
+  expected_iteration_time = max_time * time_adjust;
+  if ( current_iteration % 2 )
+  {
+    paired_combat_length = time_adjust - 1.0;
+  }
 
   analyze_number = 0;
 
@@ -1629,6 +1797,8 @@ void sim_t::reset()
   for ( auto& target : target_list )
     target -> reset();
 
+  scaling -> reset();
+
   if ( single_actor_batch )
   {
     player_no_pet_list[ current_index ] -> reset();
@@ -1889,6 +2059,8 @@ void sim_t::datacollection_end()
     b -> datacollection_end();
   }
 
+  scaling -> datacollection_end();
+
   total_dmg.add( iteration_dmg );
   raid_dps.add( current_time() != timespan_t::zero() ? iteration_dmg / current_time().total_seconds() : 0 );
   total_heal.add( iteration_heal );
@@ -1898,8 +2070,9 @@ void sim_t::datacollection_end()
 
   if ( deterministic && report_iteration_data > 0 && current_iteration > 0 && current_time() > timespan_t::zero() )
   {
+    uint64_t current_seed = common_random_numbers ? iteration_seed() : seed;
     // TODO: Metric should be selectable
-    iteration_data_entry_t entry( iteration_dmg / current_time().total_seconds(), seed, current_iteration );
+    iteration_data_entry_t entry( iteration_dmg / current_time().total_seconds(), current_seed, current_iteration );
     for ( size_t i = 0, end = target_list.size(); i < end; ++i )
     {
       const player_t* t = target_list[ i ];
@@ -1914,10 +2087,10 @@ void sim_t::datacollection_end()
     }
 
     if ( std::find_if( iteration_data.begin(), iteration_data.end(),
-                       seed_predicate_t( seed ) ) != iteration_data.end() )
+                       seed_predicate_t( current_seed ) ) != iteration_data.end() )
     {
       errorf( "[Thread-%d] Duplicate seed %llu found on iteration %u, skipping ...",
-          thread_index, seed, current_iteration );
+          thread_index, current_seed, current_iteration );
     }
     else
     {
@@ -1952,7 +2125,21 @@ void sim_t::analyze_error()
   double mean_total=0;
   int mean_count=0;
 
-  current_error = 0;
+  double max_error = 0;
+
+  // Mean and absolute error of the target metric, with control_variates=1 the metric is adjusted
+  // for the per-iteration covariates of the actor
+  auto estimate = [ this ]( player_collected_data_t& cd, double& mean, double& error ) {
+    if ( control_variates && cd.control_variate_estimate( *this, mean, error ) )
+    {
+      return;
+    }
+
+    cd.target_metric.analyze_basics();
+    cd.target_metric.analyze_variance();
+    mean = cd.target_metric.mean();
+    error = sim_t::distribution_mean_error( *this, cd.target_metric );
+  };
 
   if ( single_actor_batch )
   {
@@ -1961,12 +2148,12 @@ void sim_t::analyze_error()
     AUTO_LOCK( cd.target_metric_mutex );
     if ( cd.target_metric.size() != 0 )
     {
-      cd.target_metric.analyze_basics();
-      cd.target_metric.analyze_variance();
-      current_mean = cd.target_metric.mean();
-      if ( current_mean != 0 )
+      double mean, error;
+      estimate( cd, mean, error );
+      current_mean = mean;
+      if ( mean != 0 )
       {
-        current_error = sim_t::distribution_mean_error( *this, cd.target_metric ) / current_mean;
+        max_error = error / mean;
       }
     }
   }
@@ -1979,13 +2166,12 @@ void sim_t::analyze_error()
       AUTO_LOCK( cd.target_metric_mutex );
       if ( cd.target_metric.size() != 0 )
       {
-        cd.target_metric.analyze_basics();
-        cd.target_metric.analyze_variance();
-        double mean = cd.target_metric.mean();
+        double mean, error;
+        estimate( cd, mean, error );
         if ( mean != 0 )
         {
-          double error = sim_t::distribution_mean_error( *this, cd.target_metric ) / mean;
-          if ( error > current_error ) current_error = error;
+          error /= mean;
+          if ( error > max_error ) max_error = error;
           mean_total += mean;
           mean_count++;
         }
@@ -1998,17 +2184,18 @@ void sim_t::analyze_error()
     current_mean = mean_total / mean_count;
   }
 
-  current_error *= 100;
+  max_error *= 100;
+  current_error = max_error;
 
-  if ( current_error > 0 )
+  if ( max_error > 0 )
   {
-    if ( current_error < target_error )
+    if ( max_error < target_error )
     {
       interrupt();
     }
     else
     {
-      auto projected_iterations = static_cast<int>( n_iterations * ( ( current_error * current_error ) /
+      auto projected_iterations = static_cast<int>( n_iterations * ( ( max_error * max_error ) /
           ( target_error *  target_error ) ) );
       if ( ! strict_work_queue )
       {
@@ -2172,11 +2359,54 @@ bool sim_t::init_actors()
     }
   }
 
-  for ( size_t i = 0; i < player_no_pet_list.size(); ++i )
+  if ( parallel_actor_init && ! debug && threads > 1 && player_no_pet_list.size() > 1 )
   {
-    if ( ! init_actor( player_no_pet_list[ i ] ) )
+    // Items of players are initialized in parallel, the other phases of actor initialization
+    // register objects with the simulator (or other actors), and stay sequential in actor order.
+    // Debug simulations initialize sequentially, to keep the debug output in order.
+    std::vector<int> player_init( player_no_pet_list.size() );
+    for ( size_t i = 0; i < player_no_pet_list.size(); ++i )
     {
-      actor_init = false;
+      player_init[ i ] = init_actor_character( player_no_pet_list[ i ] );
+    }
+
+    std::atomic<size_t> next_player( 0 );
+    auto init_items = [ this, &player_init, &next_player ]() {
+      size_t i;
+      while ( ( i = next_player++ ) < player_no_pet_list.size() )
+      {
+        if ( player_init[ i ] )
+        {
+          player_init[ i ] = player_no_pet_list[ i ] -> init_items();
+        }
+      }
+    };
+
+    std::vector<std::thread> workers;
+    for ( size_t i = 1, end = std::min( static_cast<size_t>( threads ), player_no_pet_list.size() ); i < end; ++i )
+    {
+      workers.emplace_back( init_items );
+    }
+
+    init_items();
+    range::for_each( workers, []( std::thread& t ) { t.join(); } );
+
+    for ( size_t i = 0; i < player_no_pet_list.size(); ++i )
+    {
+      if ( ! player_init[ i ] || ! init_actor_content( player_no_pet_list[ i ] ) )
+      {
+        actor_init = false;
+      }
+    }
+  }
+  else
+  {
+    for ( size_t i = 0; i < player_no_pet_list.size(); ++i )
+    {
+      if ( ! init_actor( player_no_pet_list[ i ] ) )
+      {
+        actor_init = false;
+      }
     }
   }
 
@@ -2208,6 +2438,25 @@ bool sim_t::init_actors()
 // This method handles the bulk of player initialization. Order is pretty
 // critical here. Called in sim_t::init()
 bool sim_t::init_actor( player_t* p )
+{
+  if ( ! init_actor_character( p ) )
+  {
+    return false;
+  }
+
+  // Initialize each actor's items, construct gear information & stats
+  if ( ! p -> init_items() )
+  {
+    return false;
+  }
+
+  return init_actor_content( p );
+}
+
+// sim_t::init_actor_character ==============================================
+
+// Initialization of the actor up to its items
+bool sim_t::init_actor_character( player_t* p )
 {
   // initialize class/enemy modules
   for ( player_e i = PLAYER_NONE; i < PLAYER_MAX; ++i )
@@ -2241,12 +2490,14 @@ bool sim_t::init_actor( player_t* p )
     return false;
   }
 
-  // Initialize each actor's items, construct gear information & stats
-  if ( ! p -> init_items() )
-  {
-    return false;
-  }
+  return true;
+}
+
+// sim_t::init_actor_content ================================================
 
+// Initialization of the actor after its items: spells, buffs, special effects, actions and pets
+bool sim_t::init_actor_content( player_t* p )
+{
   p -> init_spells();
   p -> init_base_stats();
   p -> create_buffs();
@@ -2369,6 +2620,11 @@ bool sim_t::init()
   _rng = rng::create( rng::parse_type( rng_str ) );
   _rng -> seed( seed + thread_index );
 
+  if ( common_random_numbers )
+  {
+    _raid_event_rng = rng::create( rng::parse_type( rng_str ) );
+  }
+
   if (   queue_lag_stddev == timespan_t::zero() )   queue_lag_stddev =   queue_lag * 0.25;
   if (     gcd_lag_stddev == timespan_t::zero() )     gcd_lag_stddev =     gcd_lag * 0.25;
   if ( channel_lag_stddev == timespan_t::zero() ) channel_lag_stddev = channel_lag * 0.25;
@@ -2510,6 +2766,12 @@ bool sim_t::init()
         verify_use_items_state = false;
       }
 
+      // Fold the sim-invariant parts of the action expressions (e.g., talents, set bonuses) once
+      // the actions are initialized
+      if ( optimize_expressions )
+      {
+        actor -> fold_expressions();
+      }
     }
 
     if ( ! ret )
@@ -2613,19 +2875,33 @@ bool sim_t::iterate()
   if ( ! init() )
     return false;
 
+  // A resumed simulation may have no work left at all
+  bool more_work = true;
+  if ( checkpoint && checkpoint -> resume() )
+  {
+    more_work = work_queue -> more_work();
+  }
+
   progress_bar.init();
+  progress_bar.start_reporter();
 
   activate_actors();
 
-  bool more_work = true;
-  do
+  while ( more_work && ! canceled )
   {
+    if ( checkpoint )
+    {
+      checkpoint -> update();
+    }
+
     ++current_iteration;
     ++work_done;
 
     combat();
 
-    if ( progress_bar.update( false, as<int>(current_index) ) )
+    progress_work.store( progress_work.load( std::memory_order_relaxed ) + 1, std::memory_order_relaxed );
+
+    if ( ! progress_bar.reporting() && progress_bar.update( false, as<int>(current_index) ) )
     {
       progress_bar.output( false );
     }
@@ -2643,15 +2919,15 @@ bool sim_t::iterate()
              scaling -> scale_stat != STAT_NONE ||
              ( parent && parent -> reforge_plot -> current_stat_combo > -1 ) )
         {
-          progress_bar.update( true, static_cast<int>( old_active ) );
-          progress_bar.output( true );
-          progress_bar.restart();
+          progress_bar.finish_phase( static_cast<int>( old_active ) );
         }
 
         activate_actors();
       }
     }
-  } while ( more_work && ! canceled );
+  }
+
+  progress_bar.stop_reporter();
 
   if ( ! canceled && progress_bar.update( true, as<int>(current_index) ) )
   {
@@ -2668,6 +2944,11 @@ bool sim_t::iterate()
     progress_bar.restart();
   }
 
+  if ( checkpoint )
+  {
+    checkpoint -> finish();
+  }
+
   reset();
 
   iterations = current_iteration + 1;
@@ -2703,10 +2984,10 @@ void sim_t::do_pause()
 /// merge sims
 void sim_t::merge( sim_t& other_sim )
 {
-  auto_lock_t auto_lock( merge_mutex );
   auto start = std::chrono::high_resolution_clock::now();
 
-  if ( scaling -> scale_stat == STAT_NONE &&
+  if ( thread_index == 0 &&
+       scaling -> scale_stat == STAT_NONE &&
        scaling -> calculate_scale_factors == 0 &&
        plot -> dps_plot_stat_str.empty() &&
        reforge_plot -> reforge_plot_stat_str.empty() &&
@@ -2716,7 +2997,6 @@ void sim_t::merge( sim_t& other_sim )
   }
 
   iterations += other_sim.iterations;
-  work_per_thread[ other_sim.thread_index ] = other_sim.work_done;
 
   simulation_length.merge( other_sim.simulation_length );
   total_dmg.merge( other_sim.total_dmg );
@@ -2726,6 +3006,7 @@ void sim_t::merge( sim_t& other_sim )
   total_absorb.merge( other_sim.total_absorb );
   raid_aps.merge( other_sim.raid_aps );
   event_mgr.merge( other_sim.event_mgr );
+  scaling -> merge( *other_sim.scaling );
 
   for ( auto & buff : buff_list )
   {
@@ -2735,18 +3016,142 @@ void sim_t::merge( sim_t& other_sim )
     }
   }
 
-  for ( auto & player : actor_list )
-  {
+  // Actors only merge their own data, so they can be merged in parallel without affecting the
+  // results
+  auto merge_actor = [ this, &other_sim ]( size_t i ) {
+    player_t* player = actor_list[ i ];
     player_t* other_p = other_sim.find_player( player -> index );
     assert( other_p );
     player -> merge( *other_p );
-  }
+  };
+
+  sim_t* root = thread_index == 0 ? this : parent;
+  root -> merge_pool -> run( actor_list.size(), merge_actor );
 
   range::append( iteration_data, other_sim.iteration_data );
   merge_time += util::duration_fp_seconds( start );
   init_time += other_sim.init_time;
 }
 
+namespace {
+// Iteration data of a checkpoint, loaded data precedes the data collected so far
+struct iteration_data_archive_t
+{
+  std::vector<iteration_data_entry_t>& data;
+
+  void save( archive_t& ar ) const
+  {
+    ar.write( static_cast<uint64_t>( data.size() ) );
+    for ( const auto& entry : data )
+    {
+      ar.write( entry.metric );
+      ar.write( entry.seed );
+      ar.write( entry.iteration );
+      ar.write( entry.target_health );
+    }
+  }
+
+  void load( archive_t& ar )
+  {
+    std::vector<iteration_data_entry_t> loaded;
+    for ( auto n = ar.read<uint64_t>(); n > 0; --n )
+    {
+      double metric = ar.read<double>();
+      uint64_t seed = ar.read<uint64_t>();
+      uint64_t iteration = ar.read<uint64_t>();
+      loaded.push_back( iteration_data_entry_t( metric, seed, iteration ) );
+      ar.read( loaded.back().target_health );
+    }
+
+    data.insert( data.begin(), loaded.begin(), loaded.end() );
+  }
+};
+} // unnamed namespace
+
+/// serialize collected data and iteration state for checkpoints
+void sim_t::serialize( archive_t& ar )
+{
+  ar.state( seed );
+  ar.state( current_iteration );
+  ar.state( work_done );
+
+  ar.merge( simulation_length );
+  ar.merge( total_dmg );
+  ar.merge( raid_dps );
+  ar.merge( total_heal );
+  ar.merge( raid_hps );
+  ar.merge( total_absorb );
+  ar.merge( raid_aps );
+  event_mgr.serialize( ar );
+
+  iteration_data_archive_t iteration_data_archive { iteration_data };
+  ar.merge( iteration_data_archive );
+
+  ar.objects( buff_list, []( const buff_t* b ) { return b -> name_str; },
+              [ this ]( const std::string& name ) { return buff_t::find( this, name ); } );
+  // Actors are matched by index, as in merge(). Names of pets are not unique.
+  ar.objects( actor_list, []( const player_t* p ) { return util::to_string( p -> index ); },
+              [ this ]( const std::string& index ) { return find_player( std::stoi( index ) ); } );
+}
+
+/**
+ * @brief Tree reduction of simulator thread results
+ *
+ * At each level of the tree, the thread with index i merges the results of thread i + step into
+ * itself, if i is a multiple of 2 * step. Merges on the same level run in parallel. The tree
+ * reassociates the floating point sums of collected data, so results may differ from a sequential
+ * merge in the last bits. Deterministic simulations merge all threads into the main thread in
+ * thread index order instead. Either way, actors are merged in parallel by the threads waiting in
+ * the merge pool.
+ */
+void sim_t::merge_threads()
+{
+  // Scaling, plotting and profileset simulators have a parent, but are the main thread of their
+  // own simulation
+  sim_t* root = thread_index == 0 ? this : parent;
+  int n_threads = as<int>( root -> children.size() ) + 1;
+
+  if ( root -> deterministic )
+  {
+    if ( thread_index == 0 )
+    {
+      for ( int i = 1; i < n_threads; ++i )
+      {
+        merge_thread( i, 1 );
+      }
+    }
+    return;
+  }
+
+  for ( int step = 1; thread_index % ( 2 * step ) == 0 && thread_index + step < n_threads; step *= 2 )
+  {
+    merge_thread( thread_index + step, step );
+  }
+}
+
+/// merge the results of thread index, which contain the results of threads index .. index + size - 1
+void sim_t::merge_thread( int index, int size )
+{
+  sim_t* root = thread_index == 0 ? this : parent;
+  int n_threads = as<int>( root -> children.size() ) + 1;
+  sim_t* other = root -> children[ index - 1 ];
+
+  root -> merge_pool -> wait( index );
+
+  if ( other -> initialized )
+  {
+    merge( *other );
+    return;
+  }
+
+  // Simulator threads that failed to initialize have nothing to merge, and have not merged their
+  // subtree either
+  for ( int step = 1; step < size && index + step < n_threads; step *= 2 )
+  {
+    merge_thread( index + step, step );
+  }
+}
+
 /// merge all sims together
 void sim_t::merge()
 {
@@ -2755,7 +3160,8 @@ void sim_t::merge()
   if ( children.empty() )
     return;
 
-  merge_mutex.unlock();
+  merge_threads();
+  merge_pool -> stop();
 
   for ( size_t i = 0; i < children.size(); i++ )
   {
@@ -2763,6 +3169,7 @@ void sim_t::merge()
     if ( child )
     {
       child -> join();
+      work_per_thread[ child -> thread_index ] = child -> work_done;
       children[ i ] = nullptr;
       if ( requires_cleanup() )
       {
@@ -2772,6 +3179,7 @@ void sim_t::merge()
   }
 
   children.clear();
+  merge_pool.reset();
 }
 
 // sim_t::run ===============================================================
@@ -2780,8 +3188,12 @@ void sim_t::run()
 {
   if( iterate() )
   {
-    parent -> merge( *this );
+    merge_threads();
   }
+
+  // Help merging actors until the main thread has merged all results
+  parent -> merge_pool -> finish( thread_index );
+  parent -> merge_pool -> help();
 }
 
 // sim_t::partition =========================================================
@@ -2797,8 +3209,6 @@ void sim_t::partition()
 
   thread::set_main_thread_priority();
 
-  merge_mutex.lock(); // parent sim is locked until parent merge() is called
-
   int remainder = iterations % threads;
   iterations /= threads;
 
@@ -2806,7 +3216,9 @@ void sim_t::partition()
   // However, when we desire deterministic runs (for debugging) we need to force the
   // sims to each use a specific number of iterations as opposed to using shared pool of work.
 
-  if ( deterministic || strict_work_queue )
+  // Common random numbers pair iterations by their number in each thread, which requires a fixed
+  // number of iterations per thread as well
+  if ( deterministic || strict_work_queue || common_random_numbers )
   {
     work_queue -> init( iterations );
   }
@@ -2826,7 +3238,7 @@ void sim_t::partition()
       remainder--;
     }
 
-    if( deterministic || strict_work_queue )
+    if( deterministic || strict_work_queue || common_random_numbers )
     {
       child -> work_queue -> init( child -> iterations );
     }
@@ -2837,8 +3249,16 @@ void sim_t::partition()
     child -> report_progress = 0;
   }
 
+  // Threads of a resumed simulation share the work left over by all threads
+  if ( checkpoint && checkpoint_resume && ! ( deterministic || strict_work_queue ) )
+  {
+    work_queue -> advance( as<int>( checkpoint_t::work_done( *this ) ) );
+  }
+
   computer_process::set_priority( process_priority ); // Set main thread priority
 
+  merge_pool.reset( new merge_pool_t( threads ) );
+
   for ( auto & child : children )
     child -> launch();
 }
@@ -2850,11 +3270,21 @@ bool sim_t::execute()
   double start_cpu_time  = util::cpu_time();
   double start_wall_time = util::wall_time();
 
+  health_calibration_t::calibrate( *this );
+
   partition();
   bool success = iterate();
   merge(); // Always merge, even in cases of unsuccessful simulation!
   if( success )
+  {
+    // Results are saved as collected, analyzing transforms the collected data in place
+    if ( result_file )
+    {
+      result_file -> collect();
+    }
+
     analyze();
+  }
 
   elapsed_cpu  = util::cpu_time()  - start_cpu_time;
   elapsed_time = util::wall_time() - start_wall_time;
@@ -2884,18 +3314,17 @@ player_t* sim_t::find_player( int index ) const
 
 cooldown_t* sim_t::get_cooldown( const std::string& name )
 {
-  cooldown_t* c;
-
-  for ( size_t i = 0; i < cooldown_list.size(); ++i )
+  symbol_t symbol = symbol::intern( name );
+  cooldown_t* c = cooldown_index.find( symbol );
+  if ( c )
   {
-    c = cooldown_list[ i ];
-    if ( c -> name_str == name )
-      return c;
+    return c;
   }
 
   c = new cooldown_t( name, *this );
 
   cooldown_list.push_back( c );
+  cooldown_index.insert( symbol, c );
 
   return c;
 }
@@ -3109,8 +3538,11 @@ void sim_t::create_options()
   add_option( opt_timespan( "max_time", max_time, timespan_t::zero(), timespan_t::max() ) );
   add_option( opt_bool( "fixed_time", fixed_time ) );
   add_option( opt_float( "vary_combat_length", vary_combat_length, 0.0, 1.0 ) );
+  add_option( opt_bool( "antithetic_combat_length", antithetic_combat_length ) );
+  add_option( opt_bool( "control_variates", control_variates ) );
   add_option( opt_func( "ptr", parse_ptr ) );
   add_option( opt_int( "threads", threads ) );
+  add_option( opt_bool( "parallel_actor_init", parallel_actor_init ) );
   add_option( opt_float( "confidence", confidence, 0.0, 1.0 ) );
   add_option( opt_func( "spell_query", parse_spell_query ) );
   add_option( opt_string( "spell_query_xml_output_file", spell_query_xml_output_file_str ) );
@@ -3120,8 +3552,11 @@ void sim_t::create_options()
   add_option( opt_int( "stat_cache", stat_cache ) );
   add_option( opt_int( "max_aoe_enemies", max_aoe_enemies ) );
   add_option( opt_bool( "optimize_expressions", optimize_expressions ) );
+  add_option( opt_bool( "batch_dot_ticks", batch_dot_ticks ) );
+  add_option( opt_bool( "stats_accumulator", stats_accumulator ) );
   add_option( opt_bool( "single_actor_batch", single_actor_batch ) );
-  add_option( opt_bool( "progressbar_type", progressbar_type ) );
+  add_option( opt_int( "progressbar_type", progressbar_type, 0, 2 ) );
+  add_option( opt_bool( "progressbar_thread", progressbar_thread ) );
   // Raid buff overrides
   add_option( opt_func( "optimal_raid", parse_optimal_raid ) );
   add_option( opt_int( "override.mortal_wounds", overrides.mortal_wounds ) );
@@ -3180,6 +3615,18 @@ void sim_t::create_options()
   add_option( opt_string( "rng", rng_str ) );
   add_option( opt_bool( "deterministic", deterministic ) );
   add_option( opt_bool( "strict_work_queue", strict_work_queue ) );
+  add_option( opt_bool( "common_random_numbers", common_random_numbers ) );
+  // Checkpoints
+  add_option( opt_string( "checkpoint", checkpoint_file_str ) );
+  add_option( opt_float( "checkpoint_interval", checkpoint_interval ) );
+  add_option( opt_bool( "checkpoint_resume", checkpoint_resume ) );
+  add_option( opt_int( "enemy_health_calibration", enemy_health_calibration ) );
+  add_option( opt_float( "enemy_health_calibration_tolerance", enemy_health_calibration_tolerance ) );
+  add_option( opt_string( "enemy_health_calibration_load", enemy_health_calibration_load_str ) );
+  add_option( opt_string( "enemy_health_calibration_save", enemy_health_calibration_save_str ) );
+  // Result files
+  add_option( opt_string( "save_results", save_results_file_str ) );
+  add_option( opt_string( "load_results", load_results_file_str ) );
   add_option( opt_float( "report_iteration_data", report_iteration_data ) );
   add_option( opt_int( "min_report_iteration_data", min_report_iteration_data ) );
   add_option( opt_bool( "average_range", average_range ) );
@@ -3192,6 +3639,7 @@ void sim_t::create_options()
   add_option( opt_float( "wheel_granularity", event_mgr.wheel_granularity ) );
   add_option( opt_int( "wheel_seconds", event_mgr.wheel_seconds ) );
   add_option( opt_int( "wheel_shift", event_mgr.wheel_shift ) );
+  add_option( opt_bool( "unlink_canceled_events", event_mgr.unlink_canceled ) );
   add_option( opt_string( "reference_player", reference_player_str ) );
   add_option( opt_string( "raid_events", raid_events_str ) );
   add_option( opt_append( "raid_events+", raid_events_str ) );
@@ -3485,6 +3933,26 @@ void sim_t::setup( sim_control_t* c )
     work_queue -> batches( player_no_pet_list.size() );
   }
   work_queue -> init( iterations );
+
+  if ( ! checkpoint_file_str.empty() && single_actor_batch )
+  {
+    throw std::invalid_argument( "Checkpoints cannot be used with single_actor_batch" );
+  }
+
+  if ( checkpoint_t::enabled( *this ) )
+  {
+    checkpoint = std::unique_ptr<checkpoint_t>( new checkpoint_t( *this ) );
+  }
+
+  if ( ! save_results_file_str.empty() && ! load_results_file_str.empty() )
+  {
+    throw std::invalid_argument( "save_results and load_results cannot be used at the same time" );
+  }
+
+  if ( ! save_results_file_str.empty() && ! parent )
+  {
+    result_file = std::unique_ptr<result_file_t>( new result_file_t( *this ) );
+  }
   if ( thread_index == 0 )
   {
     work_per_thread.resize( threads );
@@ -3586,6 +4054,9 @@ void sim_t::errorf( const char* fmt, ... )
   if ( thread_index != 0 )
     return;
 
+  // Actors may report errors from multiple threads when merging
+  AUTO_LOCK( error_mutex );
+
   va_list fmtargs;
   va_start( fmtargs, fmt );
   std::string s = str::format( fmt, fmtargs );
@@ -3744,15 +4215,16 @@ sim_ostream_t& sim_ostream_t::printf( const char* fmt, ... )
 void sim_t::enable_debug_seed()
 {
   auto enabled = false;
+  uint64_t current_seed = common_random_numbers ? iteration_seed() : seed;
 
-  if ( debug_seed.size() == 1 && seed == debug_seed[ 0 ] )
+  if ( debug_seed.size() == 1 && current_seed == debug_seed[ 0 ] )
   {
     enabled = true;
   }
   else
   {
-    auto it = std::lower_bound( debug_seed.begin(), debug_seed.end(), seed );
-    enabled = it != debug_seed.end() && *it == seed;
+    auto it = std::lower_bound( debug_seed.begin(), debug_seed.end(), current_seed );
+    enabled = it != debug_seed.end() && *it == current_seed;
   }
 
   if ( enabled )
@@ -3764,7 +4236,7 @@ void sim_t::enable_debug_seed()
     }
 
     std::shared_ptr<io::ofstream> o(new io::ofstream());
-    std::string fname = output_file_str + "." + util::to_string( seed );
+    std::string fname = output_file_str + "." + util::to_string( current_seed );
     o -> open( fname );
     if ( o -> is_open() )
     {
@@ -3772,7 +4244,7 @@ void sim_t::enable_debug_seed()
       out_debug = o;
       out_log = o;
 
-      out_std.printf( "------ Iteration #%i (seed=%llu) ------", current_iteration, seed );
+      out_std.printf( "------ Iteration #%i (seed=%llu) ------", current_iteration, current_seed );
       std::flush( *out_std.get_stream() );
     }
     else
@@ -3886,6 +4358,12 @@ bool sim_t::requires_cleanup() const
     return true;
   }
 
+  // .. if we are simulating a round of enemy health calibration
+  if ( health_calibration -> calibrating() )
+  {
+    return true;
+  }
+
   // .. or finally, clean up child threads based on the "cleanup_threads" option value
   return cleanup_threads;
 }
@@ -73,6 +73,7 @@ struct attack_t;
 struct benefit_t;
 struct buff_t;
 struct callback_t;
+struct checkpoint_t;
 struct cooldown_t;
 struct cost_reduction_buff_t;
 class dbc_t;
@@ -82,14 +83,18 @@ struct expr_t;
 struct gain_t;
 struct haste_buff_t;
 struct heal_t;
+struct health_calibration_t;
 struct item_t;
 struct instant_absorb_t;
 struct module_t;
 struct pet_t;
+struct pet_spawner_base_t;
+struct dot_tick_batch_event_t;
 struct player_t;
 struct plot_t;
 struct proc_t;
 struct reforge_plot_t;
+struct result_file_t;
 struct scaling_t;
 struct sim_t;
 struct special_effect_t;
@@ -132,6 +137,9 @@ namespace highchart {
 // String Utilities
 #include "util/str.hpp"
 
+// Interned names
+#include "util/symbol.hpp"
+
 // mutex, thread
 #include "util/concurrency.hpp"
 
@@ -296,6 +304,9 @@ private:
   {
     buffer_value = 0.0;
   }
+public:
+  void serialize( archive_t& ar )
+  { ar.merge( *this ); }
 };
 
 // Raid Event
@@ -557,6 +568,8 @@ public:
   void reset() { last_start = timespan_t::min(); }
   void merge( const uptime_common_t& other )
   { uptime_sum.merge( other.uptime_sum ); }
+  void serialize( archive_t& ar )
+  { ar.merge( uptime_sum ); }
 };
 
 struct uptime_t : public uptime_common_t
@@ -822,6 +835,7 @@ public:
   player_t* const player;
   const item_t* const item;
   const std::string name_str;
+  const symbol_t name_symbol;
   const spell_data_t* s_data;
   player_t* const source;
   std::vector<event_t*> expiration;
@@ -990,6 +1004,7 @@ public:
   virtual void aura_gain();
   virtual void aura_loss();
   virtual void merge( const buff_t& other_buff );
+  virtual void serialize( archive_t& ar );
   virtual void analyze();
   virtual void datacollection_begin();
   virtual void datacollection_end();
@@ -1016,6 +1031,8 @@ public:
   static buff_t* find( const std::vector<buff_t*>&, const std::string& name, player_t* source = nullptr );
   static buff_t* find(    sim_t*, const std::string& name );
   static buff_t* find( player_t*, const std::string& name, player_t* source = nullptr );
+  static buff_t* find(    sim_t*, symbol_t name );
+  static buff_t* find( player_t*, symbol_t name, player_t* source = nullptr );
   static buff_t* find_expressable( const std::vector<buff_t*>&, const std::string& name, player_t* source = nullptr );
 
   const char* name() const { return name_str.c_str(); }
@@ -1325,10 +1342,19 @@ struct progress_bar_t
   size_t time_count;
 
   progress_bar_t( sim_t& s );
+  ~progress_bar_t();
   void init();
   bool update( bool finished = false, int index = -1 );
   void output( bool finished = false );
   void restart();
+  // With progressbar_thread=1, a reporter thread updates the progress bar while the simulation
+  // iterates, the simulator threads do not update or output progress themselves
+  void start_reporter();
+  void stop_reporter();
+  bool reporting() const;
+  // Progress bar update at the end of a phase of the simulation (e.g., an actor of a single actor
+  // batch simulation)
+  void finish_phase( int index );
   void progress();
   void set_base( const std::string& base );
   void set_phase( const std::string& phase );
@@ -1339,9 +1365,13 @@ struct progress_bar_t
 
   static std::string format_time( double t );
 private:
+  struct reporter_t;
+  std::unique_ptr<reporter_t> reporter;
+
   size_t compute_total_phases();
   bool update_simple( const sim_progress_t&, bool finished, int index );
   bool update_normal( const sim_progress_t&, bool finished, int index );
+  bool update_json( const sim_progress_t&, bool finished, int index );
 
   size_t n_stat_scaling_players( const std::string& stat ) const;
   // Compute the number of various option-related phases
@@ -1514,8 +1544,11 @@ struct event_manager_t
   stopwatch_t event_stopwatch;
   bool monitor_cpu;
   bool canceled;
+  // Canceled events are removed from the timing wheel and recycled immediately, instead of being
+  // skipped once they reach the front of the queue
+  bool unlink_canceled;
 #ifdef EVENT_QUEUE_DEBUG
-  unsigned max_queue_depth, n_allocated_events, n_end_insert, n_requested_events;
+  unsigned max_queue_depth, n_allocated_events, n_end_insert, n_requested_events, n_unlinked_events;
   uint64_t events_traversed, events_added;
   std::vector<std::pair<unsigned, unsigned> > event_queue_depth_samples;
   std::vector<unsigned> event_requested_size_count;
@@ -1526,6 +1559,8 @@ struct event_manager_t
   void* allocate_event( std::size_t size );
   void recycle_event( event_t* );
   void add_event( event_t*, timespan_t delta_time );
+  void insert_event( event_t* );
+  void unlink_event( event_t* );
   void reschedule_event( event_t* );
   event_t* next_event();
   bool execute();
@@ -1534,6 +1569,7 @@ struct event_manager_t
   void init();
   void reset();
   void merge( event_manager_t& other );
+  void serialize( archive_t& ar );
 };
 
 // Simulation Engine ========================================================
@@ -1551,11 +1587,17 @@ struct sim_t : private sc_thread_t
   // Iteration Controls
   timespan_t max_time, expected_iteration_time;
   double vary_combat_length;
+  // Pair each odd iteration with an even iteration of mirrored combat length
+  bool antithetic_combat_length;
+  double paired_combat_length;
+  // Adjust the target metric for the per-iteration crit luck and combat length of the actors
+  bool control_variates;
   int current_iteration, iterations;
   bool canceled;
   double target_error;
-  double current_error;
-  double current_mean;
+  // Written by the main thread, read by the progress reporter thread
+  std::atomic<double> current_error;
+  std::atomic<double> current_mean;
   int analyze_error_interval, analyze_number;
   // Clean up memory for threads after iterating (defaults to no in normal operation, some options
   // will force-enable the option)
@@ -1594,7 +1636,7 @@ struct sim_t : private sc_thread_t
   double      travel_variance, default_skill;
   timespan_t  reaction_time, regen_periodicity;
   timespan_t  ignite_sampling_delta;
-  bool        fixed_time, optimize_expressions;
+  bool        fixed_time, optimize_expressions, batch_dot_ticks, stats_accumulator;
   int         current_slot;
   int         optimal_raid, log, debug_each;
   std::vector<uint64_t> debug_seed;
@@ -1614,6 +1656,7 @@ struct sim_t : private sc_thread_t
   bool        requires_regen_event;
   bool        single_actor_batch;
   int         progressbar_type;
+  bool        progressbar_thread;
   int         armory_retries;
 
   // Target options
@@ -1657,13 +1700,35 @@ struct sim_t : private sc_thread_t
 
   // Random Number Generation
   std::unique_ptr<rng::rng_t> _rng;
+  // Random numbers of raid events, a separate stream with common_random_numbers=1
+  std::unique_ptr<rng::rng_t> _raid_event_rng;
   std::string rng_str;
   uint64_t seed;
   int deterministic;
   int strict_work_queue;
+  // Seed each iteration from the simulation seed and the iteration number, so that simulations
+  // with the same seed (e.g., baseline and scale factor simulations) can be compared per iteration
+  int common_random_numbers;
   int average_range, average_gauss;
   int convergence_scale;
 
+  // Checkpoints
+  std::string checkpoint_file_str;
+  double checkpoint_interval;
+  int checkpoint_resume;
+  std::unique_ptr<checkpoint_t> checkpoint;
+
+  // Enemy health calibration
+  int enemy_health_calibration;
+  double enemy_health_calibration_tolerance;
+  std::string enemy_health_calibration_load_str, enemy_health_calibration_save_str;
+  std::unique_ptr<health_calibration_t> health_calibration;
+
+  // Result files
+  std::string save_results_file_str;
+  std::string load_results_file_str;
+  std::unique_ptr<result_file_t> result_file;
+
   // Raid Events
   std::vector<std::unique_ptr<raid_event_t>> raid_events;
   std::string raid_events_str;
@@ -1719,12 +1784,14 @@ struct sim_t : private sc_thread_t
 
   // Auras and De-Buffs
   auto_dispose< std::vector<buff_t*> > buff_list;
+  symbol_index_t<buff_t> buff_index;
 
   // Global aura related delay
   timespan_t default_aura_delay;
   timespan_t default_aura_delay_stddev;
 
   auto_dispose< std::vector<cooldown_t*> > cooldown_list;
+  symbol_index_t<cooldown_t> cooldown_index;
 
   // Reporting
   progress_bar_t progress_bar;
@@ -1735,6 +1802,8 @@ struct sim_t : private sc_thread_t
   double elapsed_time;
   std::vector<size_t> work_per_thread;
   size_t work_done;
+  // Iterations completed by this thread, summed by the progress reporter thread without locking
+  std::atomic<int> progress_work;
   double     iteration_dmg, priority_iteration_dmg,  iteration_heal, iteration_absorb;
   simple_sample_data_t raid_dps, total_dmg, raid_hps, total_heal, total_absorb, raid_aps;
   extended_sample_data_t simulation_length;
@@ -1795,8 +1864,10 @@ struct sim_t : private sc_thread_t
   double scaling_normalized;
 
   // Multi-Threading
-  mutex_t merge_mutex;
+  mutex_t error_mutex;
   int threads;
+  // Initialize the items of players in parallel
+  bool parallel_actor_init;
   std::vector<sim_t*> children; // Manual delete!
   int thread_index;
   computer_process::priority_e process_priority;
@@ -1816,6 +1887,8 @@ struct sim_t : private sc_thread_t
     void batches( size_t n ) { AUTO_LOCK(m); _total_work.resize( n ); _work.resize( n ); _projected_work.resize( n ); }
 
     void flush()          { AUTO_LOCK(m); _total_work[ index ] = _projected_work[ index ] = _work[ index ]; }
+    // Skip work already done (resumed simulations)
+    void advance( int w ) { AUTO_LOCK(m); _work[ index ] = std::min( _work[ index ] + w, _total_work[ index ] ); }
     int  size()           { AUTO_LOCK(m); return index < _total_work.size() ? _total_work[ index ] : _total_work.back(); }
     bool more_work()      { AUTO_LOCK(m); return index < _total_work.size() && _work[ index ] < _total_work[ index ]; }
 
@@ -1941,11 +2014,14 @@ struct sim_t : private sc_thread_t
   bool      init_parties();
   bool      init_actors();
   bool      init_actor( player_t* );
+  bool      init_actor_character( player_t* );
+  bool      init_actor_content( player_t* );
   bool      init_actor_pets();
   bool      init();
   void      analyze();
   void      merge( sim_t& other_sim );
   void      merge();
+  void      serialize( archive_t& );
   bool      iterate();
   void      partition();
   bool      execute();
@@ -1981,6 +2057,9 @@ struct sim_t : private sc_thread_t
   { target_data_initializer.push_back( cb ); }
   rng::rng_t& rng() const
   { return *_rng; }
+  rng::rng_t& raid_event_rng() const
+  { return _raid_event_rng ? *_raid_event_rng : *_rng; }
+  uint64_t iteration_seed() const;
   double averaged_range( double min, double max )
   {
     if ( average_range ) return ( min + max ) / 2.0;
@@ -1992,6 +2071,11 @@ private:
   void enable_debug_seed();
   void disable_debug_seed();
   bool requires_cleanup() const;
+  void merge_threads();
+  void merge_thread( int index, int size );
+
+  struct merge_pool_t;
+  std::unique_ptr<merge_pool_t> merge_pool; // Main thread only, while simulator threads run
 };
 
 // Module ===================================================================
@@ -2097,15 +2181,29 @@ struct scaling_t
   std::string scale_over;
   scale_metric_e scaling_metric;
   std::string scale_over_player;
+  // Estimate scale factors with a single simulation that perturbs all scaled stats each iteration
+  int    scale_regression;
 
   // Gear delta for determining scale factors
   gear_stats_t stats;
 
+  // Stats perturbed by a regression simulation, the perturbation of the current iteration, and the
+  // perturbations of all iterations with collected data (one row per iteration)
+  std::vector<stat_e> perturbed_stats;
+  std::vector<double> perturbation_deltas;
+  std::vector<double> perturbation;
+  std::vector<double> perturbations;
+
   scaling_t( sim_t* s );
 
   void init_deltas();
   void analyze();
   void analyze_stats();
+  std::vector<stat_e> analyze_stats_regression( const std::vector<stat_e>& stats_to_scale );
+  void reset();
+  void perturb( player_t* p ) const;
+  void datacollection_end();
+  void merge( const scaling_t& other );
   void analyze_ability_stats( stat_e, double, player_t*, player_t*, player_t* );
   void analyze_lag();
   void normalize();
@@ -2116,6 +2214,13 @@ struct scaling_t
 
 // Plot =====================================================================
 
+struct plot_data_t
+{
+  double plot_step;
+  double value;
+  double error;
+};
+
 struct plot_t
 {
 public:
@@ -2126,15 +2231,20 @@ public:
   int    dps_plot_iterations;
   double dps_plot_target_error;
   int    dps_plot_debug;
+  int    dps_plot_parallel; // Number of plot points simulated concurrently
   stat_e current_plot_stat;
   int    num_plot_stats, remaining_plot_stats, remaining_plot_points;
   bool   dps_plot_positive, dps_plot_negative;
+  int    num_plot_points;
+  std::atomic<int> simulated_plot_points;
 
   plot_t( sim_t* s );
   void analyze();
   double progress( std::string& phase, std::string* detailed = nullptr );
 private:
   void analyze_stats();
+  void simulate_points( const std::vector<std::pair<stat_e, int>>& points,
+                        std::vector<std::vector<plot_data_t>>& results );
   void write_output_file();
   void create_options();
 };
@@ -2152,6 +2262,8 @@ struct reforge_plot_t
   int    reforge_plot_iterations;
   double reforge_plot_target_error;
   int    reforge_plot_debug;
+  // Number of reforge combinations simulated by an adaptive reforge plot, 0 simulates all of them
+  int    reforge_plot_adaptive;
   int    current_stat_combo;
   int    num_stat_combos;
 
@@ -2165,17 +2277,13 @@ struct reforge_plot_t
   void analyze_stats();
   double progress( std::string& phase, std::string* detailed = nullptr );
 private:
+  bool simulate( const std::vector<int>& stat_mods, std::vector<std::vector<plot_data_t>>& results );
+  std::vector<size_t> select_adaptive( const std::vector<std::vector<int>>& stat_mods,
+                                       std::vector<std::vector<std::vector<plot_data_t>>>& results );
   void write_output_file();
   void create_options();
 };
 
-struct plot_data_t
-{
-  double plot_step;
-  double value;
-  double error;
-};
-
 // Event ====================================================================
 //
 // core_event_t is designed to be a very simple light-weight event transporter and
@@ -2189,6 +2297,9 @@ struct event_t : private noncopyable
 {
   sim_t& _sim;
   event_t*    next;
+  // Link pointing to this event in its timing wheel slice (the slice head, or the next pointer
+  // of the preceding event), nullptr if the event is not in the timing wheel
+  event_t**   prev_next;
   timespan_t  time;
   timespan_t  reschedule_time;
   unsigned    id;
@@ -2883,6 +2994,8 @@ public:
   { ratio.add( up != 0 ? 100.0 * up / ( down + up ) : 0.0 ); }
   void merge( const benefit_t& other )
   { ratio.merge( other.ratio ); }
+  void serialize( archive_t& ar )
+  { ar.merge( ratio ); }
 
   const char* name() const
   { return name_str.c_str(); }
@@ -2937,6 +3050,12 @@ public:
     interval_sum.merge( other.interval_sum );
   }
 
+  void serialize( archive_t& ar )
+  {
+    ar.merge( count );
+    ar.merge( interval_sum );
+  }
+
   void datacollection_begin()
   { iteration_count = 0; }
   void datacollection_end()
@@ -3259,8 +3378,16 @@ struct effect_callbacks_t
 
   proc_array_t procs;
 
+#ifdef CALLBACK_STATS
+  // Callback trigger attempts, and attempts that triggered the proc
+  uint64_t n_evaluated, n_triggered;
+
+  effect_callbacks_t( sim_t* sim ) : sim( sim ), n_evaluated( 0 ), n_triggered( 0 )
+  { }
+#else
   effect_callbacks_t( sim_t* sim ) : sim( sim )
   { }
+#endif /* CALLBACK_STATS */
 
   bool has_callback( const std::function<bool(const T_CB*)> cmp ) const
   { return range::find_if( all_callbacks, cmp ) != all_callbacks.end(); }
@@ -3271,6 +3398,17 @@ struct effect_callbacks_t
   void reset();
 
   void register_callback( unsigned proc_flags, unsigned proc_flags2, T_CB* cb );
+
+  // Trigger the callbacks of a proc type for an action
+  void trigger( proc_types type, proc_types2 type2, action_t* a, void* call_data );
+
+#ifdef CALLBACK_STATS
+  void merge( const effect_callbacks_t& other )
+  {
+    n_evaluated += other.n_evaluated;
+    n_triggered += other.n_triggered;
+  }
+#endif /* CALLBACK_STATS */
 private:
   void add_proc_callback( proc_types type, unsigned flags, T_CB* cb );
 };
@@ -3454,6 +3592,8 @@ struct player_collected_data_t
 
   // Metric used to end simulations early
   extended_sample_data_t target_metric;
+  // Per-iteration covariates of the target metric, for control_variates=1
+  extended_sample_data_t target_metric_crit_luck, target_metric_combat_length;
   mutex_t target_metric_mutex;
 
   std::vector<simple_sample_data_t> resource_lost, resource_gained;
@@ -3515,11 +3655,12 @@ struct player_collected_data_t
   // used.
   int total_iterations;
 
+  // Decoded entry of the sample sequence, see action_sequence_t
   struct action_sequence_data_t
   {
     const action_t* action;
     const player_t* target;
-    const timespan_t time;
+    timespan_t time;
     timespan_t wait_time;
     std::vector< std::pair< buff_t*, std::vector<double> > > buff_list;
     std::vector< std::pair< cooldown_t*, std::vector<double> > > cooldown_list;
@@ -3527,11 +3668,88 @@ struct player_collected_data_t
     std::array<double, RESOURCE_MAX> resource_snapshot;
     std::array<double, RESOURCE_MAX> resource_max_snapshot;
 
-    action_sequence_data_t( const timespan_t& ts, const timespan_t& wait, const player_t* p );
-    action_sequence_data_t( const action_t* a, const player_t* t, const timespan_t& ts, const player_t* p );
+    action_sequence_data_t( const action_t* a, const player_t* t, const timespan_t& ts, const timespan_t& wait );
   };
-  auto_dispose< std::vector<action_sequence_data_t*> > action_sequence;
-  auto_dispose< std::vector<action_sequence_data_t*> > action_sequence_precombat;
+
+  // Sample sequence of the recorded iteration. Actions and waits are recorded as fixed-size
+  // records, their buff, cooldown, debuff, and resource snapshots are appended to flat arenas that
+  // are reserved when the actor is initialized. The records are only decoded into
+  // action_sequence_data_t entries when the report is generated.
+  class action_sequence_t
+  {
+    struct buff_record_t
+    {
+      buff_t* buff;
+      int stacks;
+      double remains;
+    };
+
+    struct cooldown_record_t
+    {
+      cooldown_t* cooldown;
+      int charges;
+      double remains;
+    };
+
+    struct target_record_t
+    {
+      player_t* target;
+      uint32_t debuff_begin, debuff_end;
+    };
+
+    struct resource_record_t
+    {
+      resource_e resource;
+      double current, max;
+    };
+
+    struct record_t
+    {
+      const action_t* action;
+      const player_t* target;
+      timespan_t time;
+      timespan_t wait_time;
+      // Cooldowns, debuffs, and buff remains are only recorded with json_full_states=1
+      bool full_state;
+      uint32_t buff_begin, buff_end;
+      uint32_t cooldown_begin, cooldown_end;
+      uint32_t target_begin, target_end;
+      uint32_t resource_begin, resource_end;
+    };
+
+    std::vector<record_t> records;
+    std::vector<buff_record_t> buffs;
+    std::vector<cooldown_record_t> cooldowns;
+    std::vector<target_record_t> targets;
+    std::vector<resource_record_t> resources;
+
+    void snapshot_buffs( const player_t* p );
+    void snapshot( record_t& record, const player_t* p );
+    void decode_buffs( uint32_t begin, uint32_t end, bool remains,
+                       std::vector< std::pair< buff_t*, std::vector<double> > >& out ) const;
+  public:
+    // Reserve the arenas for an iteration of (up to) n actions
+    void reserve( size_t n );
+    void clear();
+    bool empty() const
+    { return records.empty(); }
+    size_t size() const
+    { return records.size(); }
+
+    void add( const action_t* a, const player_t* target, const timespan_t& ts, const player_t* p );
+    // Consecutive waits are merged into one entry
+    void add_wait( const timespan_t& amount, const timespan_t& ts, const player_t* p );
+
+    std::vector<action_sequence_data_t> decode() const;
+
+    // Result files store the actions, buffs, cooldowns, and targets of the sequence of actor p as
+    // indices into the lists of the actors, and resolve them against the actors of the loading
+    // simulation
+    void save( archive_t& ar, const player_t* p ) const;
+    void load( archive_t& ar, const player_t* p );
+  };
+  action_sequence_t action_sequence;
+  action_sequence_t action_sequence_precombat;
 
   // Buffed snapshot_stats (for reporting)
   struct buffed_stats_t
@@ -3551,8 +3769,10 @@ struct player_collected_data_t
   player_collected_data_t( const player_t* player );
   void reserve_memory( const player_t& );
   void merge( const player_collected_data_t& );
+  void serialize( archive_t& );
   void analyze( const player_t& );
   void collect_data( const player_t& );
+  bool control_variate_estimate( const sim_t& sim, double& mean, double& error ) const;
   void print_tmi_debug_csv( const sc_timeline_t* nma, const std::vector<double>& weighted_value, const player_t& p );
   double calculate_tmi( const health_changes_timeline_t& tl, int window, double f_length, const player_t& p );
   double calculate_max_spike_damage( const health_changes_timeline_t& tl, int window );
@@ -3757,12 +3977,15 @@ struct scaling_metric_data_t {
   std::string name;
   double value, stddev;
   scale_metric_e metric;
+  // Per-iteration samples of the metric, if collected
+  const extended_sample_data_t* samples;
   scaling_metric_data_t( scale_metric_e m, const std::string& n, double v, double dev ) :
-    name( n ), value( v ), stddev( dev ), metric( m ) {}
+    name( n ), value( v ), stddev( dev ), metric( m ), samples( nullptr ) {}
   scaling_metric_data_t( scale_metric_e m, const extended_sample_data_t& sd ) :
-    name( sd.name_str ), value( sd.mean() ), stddev( sd.mean_std_dev ), metric( m ) {}
+    name( sd.name_str ), value( sd.mean() ), stddev( sd.mean_std_dev ), metric( m ),
+    samples( sd.simple ? nullptr : &sd ) {}
   scaling_metric_data_t( scale_metric_e m, const sc_timeline_t& tl, const std::string& name ) :
-    name( name ), value( tl.mean() ), stddev( tl.mean_stddev() ), metric( m ) {}
+    name( name ), value( tl.mean() ), stddev( tl.mean_stddev() ), metric( m ), samples( nullptr ) {}
 };
 
 struct player_scaling_t
@@ -3840,6 +4063,9 @@ struct player_t : public actor_t
   timespan_t started_waiting;
   std::vector<pet_t*> pet_list;
   std::vector<pet_t*> active_pets;
+  auto_dispose< std::vector<pet_spawner_base_t*> > pet_spawners;
+  // Pending batches of ticks of the dots this actor is the source of (batch_dot_ticks=1)
+  std::vector<dot_tick_batch_event_t*> dot_tick_batches;
   std::vector<absorb_buff_t*> absorb_buff_list;
   std::map<unsigned,instant_absorb_t> instant_absorb_list;
 
@@ -4059,8 +4285,16 @@ struct player_t : public actor_t
   auto_dispose< std::vector<real_ppm_t*> > rppm_list;
   auto_dispose< std::vector<shuffled_rng_t*> > shuffled_rng_list;
   std::vector<cooldown_t*> dynamic_cooldown_list;
+  // Name lookup of buffs (by name and source), cooldowns, dots (by name and source), gains and procs
+  symbol_index_t<buff_t> buff_index;
+  symbol_index_t<cooldown_t> cooldown_index;
+  symbol_index_t<dot_t> dot_index;
+  symbol_index_t<gain_t> gain_index;
+  symbol_index_t<proc_t> proc_index;
   std::array< std::vector<plot_data_t>, STAT_MAX > dps_plot_data;
   std::vector<std::vector<plot_data_t> > reforge_plot_data;
+  // Response surface fitted to an adaptive reforge plot, evaluated at every reforge combination
+  std::vector<std::vector<plot_data_t> > reforge_plot_surface;
   auto_dispose< std::vector<luxurious_sample_data_t*> > sample_data_list;
 
   // All Data collected during / end of combat
@@ -4068,6 +4302,7 @@ struct player_t : public actor_t
 
   // Damage
   double iteration_dmg, priority_iteration_dmg, iteration_dmg_taken; // temporary accumulators
+  double iteration_crit_luck; // Crits minus expected crits of the player and its pets, for control_variates=1
   double dpr;
   std::vector<std::pair<timespan_t, double> > incoming_damage; // for tank active mitigation conditionals
 
@@ -4316,10 +4551,15 @@ struct player_t : public actor_t
   // Verify that the user input (APL) contains an use-item line for all on-use items
   virtual bool verify_use_items() const;
 
+  // Fold the sim-invariant parts of the action expressions, and remove the actions that can never
+  // be executed from the action priority lists
+  void fold_expressions();
+
   virtual void reset();
   virtual void combat_begin();
   virtual void combat_end();
   virtual void merge( player_t& other );
+  virtual void serialize( archive_t& ar );
 
   virtual void datacollection_begin();
   virtual void datacollection_end();
@@ -4637,7 +4877,9 @@ struct player_t : public actor_t
   item_t*     find_item( unsigned );
   action_t*   find_action( const std::string& ) const;
   cooldown_t* find_cooldown( const std::string& name ) const;
+  cooldown_t* find_cooldown( symbol_t name ) const;
   dot_t*      find_dot     ( const std::string& name, player_t* source ) const;
+  dot_t*      find_dot     ( symbol_t name, player_t* source ) const;
   stats_t*    find_stats   ( const std::string& name ) const;
   gain_t*     find_gain    ( const std::string& name ) const;
   proc_t*     find_proc    ( const std::string& name ) const;
@@ -4650,6 +4892,7 @@ struct player_t : public actor_t
   real_ppm_t* get_rppm    ( const std::string& name, double freq, double mod = 1.0, rppm_scale_e s = RPPM_NONE );
   shuffled_rng_t* get_shuffled_rng(const std::string& name, int success_entries = 0, int total_entries = 0);
   dot_t*      get_dot     ( const std::string& name, player_t* source );
+  dot_t*      get_dot     ( symbol_t name, player_t* source );
   gain_t*     get_gain    ( const std::string& name );
   proc_t*     get_proc    ( const std::string& name );
   stats_t*    get_stats   ( const std::string& name, action_t* action = nullptr );
@@ -5015,6 +5258,8 @@ struct pet_t : public player_t
   double intellect_per_owner;
   bool summoned;
   bool dynamic;
+  // Pet spawner the pet belongs to
+  pet_spawner_base_t* spawner;
   pet_e pet_type;
   event_t* expiration;
   timespan_t duration;
@@ -5120,6 +5365,104 @@ public:
   { return active_during_iteration || ( dynamic && sim -> report_pets_separately == 1 ); }
 };
 
+// Pet Spawner ==============================================================
+
+/* Pool of pets of the same type that are summoned and dismissed dynamically (e.g., wild imps).
+ *
+ * Sleeping pets are kept in a free list, so summoning does not scan the pool. All pets of the pool
+ * are created with the owner and initialized with the other actors, the pool never grows. A summon
+ * that finds no sleeping pet never fails, the longest active pet is summoned again. All pets of the
+ * pool share the action statistics of the first pet, so the pool is reported as a single pet. Pets
+ * of a pool should only be summoned through the spawner.
+ */
+struct pet_spawner_base_t : private noncopyable
+{
+  typedef std::function<pet_t*( player_t* )> creator_fn_t;
+
+private:
+  player_t* m_owner;
+  std::string m_name;
+  creator_fn_t m_creator;
+  std::vector<pet_t*> m_pets;
+  std::vector<pet_t*> m_free;
+  // Active pets in summon order
+  std::vector<pet_t*> m_active;
+
+  pet_t* create();
+  void release( pet_t* pet );
+
+public:
+  // Creates the n_pets (at least one) pets of the pool
+  pet_spawner_base_t( player_t* owner, const std::string& name, const creator_fn_t& creator,
+                      size_t n_pets );
+  virtual ~pet_spawner_base_t() { }
+
+  // Take a pet out of the pool, the caller must summon the pet
+  pet_t* acquire();
+  // Summon a pet of the pool
+  pet_t* spawn( timespan_t duration = timespan_t::zero() );
+  // Return all pets to the free list. Called by the owner.
+  void reset();
+
+  const std::string& name() const
+  { return m_name; }
+
+  player_t* owner() const
+  { return m_owner; }
+
+  // All pets of the pool, and the pets summoned through the spawner
+  const std::vector<pet_t*>& pets() const
+  { return m_pets; }
+
+  const std::vector<pet_t*>& active_pets() const
+  { return m_active; }
+
+  size_t n_active_pets() const
+  { return m_active.size(); }
+};
+
+template <typename T>
+struct pet_spawner_t : public pet_spawner_base_t
+{
+  struct iterator_t
+  {
+    std::vector<pet_t*>::const_iterator it;
+
+    T* operator*() const
+    { return debug_cast<T*>( *it ); }
+
+    iterator_t& operator++()
+    { ++it; return *this; }
+
+    bool operator!=( const iterator_t& other ) const
+    { return it != other.it; }
+  };
+
+  pet_spawner_t( player_t* owner, const std::string& name, const std::function<T*( player_t* )>& creator,
+                 size_t n_pets ) :
+    pet_spawner_base_t( owner, name, creator, n_pets )
+  { }
+
+  T* acquire()
+  { return debug_cast<T*>( pet_spawner_base_t::acquire() ); }
+
+  T* spawn( timespan_t duration = timespan_t::zero() )
+  { return debug_cast<T*>( pet_spawner_base_t::spawn( duration ) ); }
+
+  T* operator[]( size_t index ) const
+  { return debug_cast<T*>( pets()[ index ] ); }
+
+  size_t size() const
+  { return pets().size(); }
+
+  // Iterates over all pets of the pool
+  iterator_t begin() const
+  { return iterator_t { pets().begin() }; }
+
+  iterator_t end() const
+  { return iterator_t { pets().end() }; }
+};
+
 
 // Gain =====================================================================
 
@@ -5142,6 +5485,11 @@ public:
     for ( resource_e i = RESOURCE_NONE; i < RESOURCE_MAX; i++ )
     { actual[ i ] += other.actual[ i ]; overflow[ i ] += other.overflow[ i ]; count[ i ] += other.count[ i ]; }
   }
+  void serialize( archive_t& ar )
+  {
+    for ( resource_e i = RESOURCE_NONE; i < RESOURCE_MAX; i++ )
+    { ar.add( actual[ i ] ); ar.add( overflow[ i ] ); ar.add( count[ i ] ); }
+  }
   void analyze( size_t iterations )
   {
     for ( resource_e i = RESOURCE_NONE; i < RESOURCE_MAX; i++ )
@@ -5199,12 +5547,34 @@ public:
     stats_results_t();
     void analyze( double num_results );
     void merge( const stats_results_t& other );
+    void serialize( archive_t& ar );
     void datacollection_begin();
     void datacollection_end();
   };
   std::array<stats_results_t,FULLTYPE_MAX> direct_results;
   std::array<stats_results_t,RESULT_MAX> tick_results;
 
+  // Results in a structure-of-arrays layout (stats_accumulator=1), indexed by the direct result
+  // type followed by the tick result type (see result_index()). Holds the per-iteration counts and
+  // amounts, and the values not yet folded into the actual_amount and total_amount sample data of
+  // direct_results and tick_results (see fold_results()). The pending sums continue from the sums
+  // of the sample data, so the folded sample data is identical to adding each result to it.
+  struct result_accumulator_t
+  {
+    static const size_t N_RESULTS = FULLTYPE_MAX + RESULT_MAX;
+
+    std::array<int, N_RESULTS> count;
+    std::array<double, N_RESULTS> actual_amount, total_amount;
+
+    std::array<size_t, N_RESULTS> pending;
+    std::array<double, N_RESULTS> actual_sum, total_sum;
+    std::array<double, N_RESULTS> actual_min, actual_max;
+
+    result_accumulator_t();
+    void datacollection_begin();
+  };
+  std::unique_ptr<result_accumulator_t> iteration_results;
+
   // Reporting only
   std::array<double, RESOURCE_MAX> resource_portion, apr, rpe;
   double rpe_sum, compound_amount, overkill_pct;
@@ -5226,15 +5596,20 @@ public:
   void add_child( stats_t* child );
   void consume_resource( resource_e resource_type, double resource_amount );
   full_result_e translate_result( result_e result, block_result_e block_result );
+  size_t result_index( dmg_e dmg_type, result_e result, block_result_e block_result );
+  stats_results_t& results( size_t index )
+  { return index < FULLTYPE_MAX ? direct_results[ index ] : tick_results[ index - FULLTYPE_MAX ]; }
   void add_result( double act_amount, double tot_amount, dmg_e dmg_type, result_e result, block_result_e block_result, player_t* target );
   void add_execute( timespan_t time, player_t* target );
   void add_tick   ( timespan_t time, player_t* target );
   void add_refresh( player_t* target );
+  void fold_results();
   void datacollection_begin();
   void datacollection_end();
   void reset();
   void analyze();
   void merge( const stats_t& other );
+  void serialize( archive_t& ar );
   const char* name() const { return name_str.c_str(); }
 
   bool has_direct_amount_results() const;
@@ -5906,6 +6281,8 @@ public:
 
   virtual block_result_e calculate_block_result( action_state_t* s ) const;
 
+  void record_crit_luck( double chance, bool crit ) const;
+
   virtual double calculate_direct_amount( action_state_t* state ) const;
 
   virtual double calculate_tick_amount( action_state_t* state, double multiplier ) const;
@@ -6174,6 +6551,10 @@ public:
 
   virtual bool init_finished();
 
+  // Fold the sim-invariant parts of the expressions of the action, returns the number of
+  // expression nodes eliminated
+  int fold_expressions();
+
   virtual void reset();
 
   virtual void cancel();
@@ -6660,6 +7041,11 @@ private:
   virtual const char* name() const override
   { return "Dot Tick"; }
   dot_t* dot;
+
+  // Schedule the tick in the batch of ticks of the dot source at the same time (see sc_dot.cpp)
+  static void schedule_batched( dot_tick_event_t* e, timespan_t time_to_tick );
+
+  friend struct dot_tick_batch_event_t;
 };
 
 // DoT End Event ===========================================================
@@ -6700,6 +7086,7 @@ public:
   timespan_t miss_time;
   timespan_t time_to_tick;
   std::string name_str;
+  symbol_t name_symbol;
 
   dot_t( const std::string& n, player_t* target, player_t* source );
 
@@ -6757,9 +7144,14 @@ inline double action_t::last_tick_factor( const dot_t* /* d */, const timespan_t
 { return std::min( 1.0, duration / time_to_tick ); }
 
 inline dot_tick_event_t::dot_tick_event_t( dot_t* d, timespan_t time_to_tick ) :
-    event_t( *d -> source, time_to_tick ),
+    event_t( *d -> source ),
   dot( d )
 {
+  if ( sim().batch_dot_ticks )
+    schedule_batched( this, time_to_tick );
+  else
+    schedule( time_to_tick );
+
   if ( sim().debug )
     sim().out_debug.printf( "New DoT Tick Event: %s %s %d-of-%d %.4f",
                 d -> source -> name(), dot -> name(), dot -> current_tick + 1, dot -> num_ticks, time_to_tick.total_seconds() );
@@ -6966,6 +7358,10 @@ struct dbc_proc_callback_t : public action_callback_t
                                  a -> name(), triggered );
     if ( triggered )
     {
+#ifdef CALLBACK_STATS
+      listener -> callbacks.n_triggered++;
+#endif
+
       execute( a, static_cast<action_state_t*>( call_data ) );
 
       if ( cooldown )
@@ -8027,11 +8423,19 @@ void initialize_concordance( player_t& );
 
 inline buff_t* buff_t::find( sim_t* s, const std::string& name )
 {
-  return find( s -> buff_list, name );
+  return find( s, symbol::find( name ) );
 }
 inline buff_t* buff_t::find( player_t* p, const std::string& name, player_t* source )
 {
-  return find( p -> buff_list, name, source );
+  return find( p, symbol::find( name ), source );
+}
+inline buff_t* buff_t::find( sim_t* s, symbol_t name )
+{
+  return s -> buff_index.find( name );
+}
+inline buff_t* buff_t::find( player_t* p, symbol_t name, player_t* source )
+{
+  return p -> buff_index.find( name, source );
 }
 inline std::string buff_t::source_name() const
 {
@@ -8811,6 +9215,28 @@ void effect_callbacks_t<T_CB>::reset()
   T_CB::reset( all_callbacks );
 }
 
+// effect_callbacks_t::trigger ===============================================
+
+template <typename T_CB>
+void effect_callbacks_t<T_CB>::trigger( proc_types type, proc_types2 type2, action_t* a, void* call_data )
+{
+  if ( a && ! a -> player -> in_combat ) return;
+
+  const proc_list_t& callbacks = procs[ type ][ type2 ];
+  for ( size_t i = 0, size = callbacks.size(); i < size; i++ )
+  {
+    T_CB* cb = callbacks[ i ];
+    if ( cb -> active )
+    {
+      if ( ! cb -> allow_procs && a && a -> proc ) return;
+#ifdef CALLBACK_STATS
+      n_evaluated++;
+#endif
+      cb -> trigger( a, call_data );
+    }
+  }
+}
+
 /**
  * Targetdata initializer for items. When targetdata is constructed (due to a call to
  * player_t::get_target_data failing to find an object for the given target), all targetdata
@@ -0,0 +1,343 @@
+// ==========================================================================
+// Dedmonwakeen's Raid DPS/TPS Simulator.
+// Send questions to natehieter@gmail.com
+// ==========================================================================
+
+#ifndef SC_ARCHIVE_HPP
+#define SC_ARCHIVE_HPP
+
+#include <cstdint>
+#include <cstring>
+#include <set>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include "util/generic.hpp"
+
+/* Binary archive of collected simulation data
+ *
+ * Objects describe their data once, in a serialize( archive_t& ) method, that is used both for
+ * saving and for loading. Loading merges the archived data into the existing objects, so that
+ * loading into freshly initialized objects restores them exactly:
+ *  - add(): accumulated values, loaded values are added to the current value
+ *  - state(): plain state, loaded values overwrite the current value (first load pass only)
+ *  - merge(): leaf containers (sample data, timelines) with save() / load() methods
+ *  - object(), objects(): objects implementing serialize( archive_t& ), objects() matches objects
+ *    by name when loading
+ *  - sequence(): unnamed elements of an object, matched by index when loading
+ *
+ * Every object and leaf is stored as a length-prefixed record, so data of objects that do not exist
+ * (yet) can be skipped. Objects created lazily during the simulation can be loaded on a later pass,
+ * records that were already loaded are not loaded twice.
+ */
+class archive_t : private noncopyable
+{
+public:
+  enum mode_e
+  {
+    SAVE,
+    LOAD
+  };
+
+private:
+  mode_e m_mode;
+  std::string m_data;
+  size_t m_pos;
+  unsigned m_pass;
+  // Values of the current object were already loaded on an earlier pass
+  bool m_loaded;
+  std::set<size_t> m_loaded_records;
+
+  size_t begin_record()
+  {
+    size_t pos = m_data.size();
+    write( uint64_t() );
+    return pos;
+  }
+
+  void end_record( size_t pos )
+  {
+    uint64_t length = m_data.size() - pos - sizeof( uint64_t );
+    std::memcpy( &m_data[ pos ], &length, sizeof( length ) );
+  }
+
+  // Returns the end position of the record starting at the current position
+  size_t record_end()
+  {
+    auto length = read<uint64_t>();
+    if ( length > m_data.size() - m_pos )
+    {
+      throw std::runtime_error( "Truncated archive record" );
+    }
+    return m_pos + static_cast<size_t>( length );
+  }
+
+  template <typename T>
+  static void serialize_object( archive_t& ar, T* obj )
+  { obj -> serialize( ar ); }
+
+  template <typename T>
+  static void serialize_object( archive_t& ar, T& obj )
+  { obj.serialize( ar ); }
+
+public:
+  // Saving archive
+  archive_t() : m_mode( SAVE ), m_pos( 0 ), m_pass( 0 ), m_loaded( false )
+  { }
+
+  // Loading archive over previously saved data
+  explicit archive_t( const std::string& data ) :
+    m_mode( LOAD ), m_data( data ), m_pos( 0 ), m_pass( 0 ), m_loaded( false )
+  { }
+
+  bool saving() const
+  { return m_mode == SAVE; }
+
+  bool loading() const
+  { return m_mode == LOAD; }
+
+  const std::string& data() const
+  { return m_data; }
+
+  bool eof() const
+  { return m_pos >= m_data.size(); }
+
+  // Start another load pass from the given position
+  void rewind( size_t pos )
+  {
+    m_pass++;
+    m_pos = pos;
+  }
+
+  size_t position() const
+  { return m_pos; }
+
+  // Raw values ===============================================================
+
+  template <typename T>
+  void write( const T& v )
+  {
+    static_assert( std::is_arithmetic<T>::value || std::is_enum<T>::value, "Only plain values can be written" );
+    m_data.append( reinterpret_cast<const char*>( &v ), sizeof( v ) );
+  }
+
+  void write( const std::string& v )
+  {
+    write( static_cast<uint64_t>( v.size() ) );
+    m_data.append( v );
+  }
+
+  template <typename T>
+  void write( const std::vector<T>& v )
+  {
+    static_assert( std::is_arithmetic<T>::value, "Only plain values can be written" );
+    write( static_cast<uint64_t>( v.size() ) );
+    m_data.append( reinterpret_cast<const char*>( v.data() ), v.size() * sizeof( T ) );
+  }
+
+  template <typename T>
+  T read()
+  {
+    static_assert( std::is_arithmetic<T>::value || std::is_enum<T>::value, "Only plain values can be read" );
+    T v;
+    if ( m_data.size() - m_pos < sizeof( v ) )
+    {
+      throw std::runtime_error( "Truncated archive" );
+    }
+    std::memcpy( &v, &m_data[ m_pos ], sizeof( v ) );
+    m_pos += sizeof( v );
+    return v;
+  }
+
+  void read( std::string& v )
+  {
+    auto length = read<uint64_t>();
+    if ( length > m_data.size() - m_pos )
+    {
+      throw std::runtime_error( "Truncated archive" );
+    }
+    v.assign( m_data, m_pos, static_cast<size_t>( length ) );
+    m_pos += static_cast<size_t>( length );
+  }
+
+  template <typename T>
+  void read( std::vector<T>& v )
+  {
+    auto length = read<uint64_t>();
+    if ( length > ( m_data.size() - m_pos ) / sizeof( T ) )
+    {
+      throw std::runtime_error( "Truncated archive" );
+    }
+    v.resize( static_cast<size_t>( length ) );
+    std::memcpy( v.data(), &m_data[ m_pos ], v.size() * sizeof( T ) );
+    m_pos += v.size() * sizeof( T );
+  }
+
+  // Serialization ============================================================
+
+  // Accumulated value
+  template <typename T>
+  void add( T& v )
+  {
+    if ( saving() )
+    {
+      write( v );
+      return;
+    }
+
+    T other = read<T>();
+    if ( ! m_loaded )
+    {
+      v += other;
+    }
+  }
+
+  // Accumulated maximum
+  template <typename T>
+  void maximum( T& v )
+  {
+    if ( saving() )
+    {
+      write( v );
+      return;
+    }
+
+    T other = read<T>();
+    if ( ! m_loaded && other > v )
+    {
+      v = other;
+    }
+  }
+
+  // Simulation state, only restored on the first load pass
+  template <typename T>
+  void state( T& v )
+  {
+    if ( saving() )
+    {
+      write( v );
+      return;
+    }
+
+    T other = read<T>();
+    if ( ! m_loaded && m_pass == 0 )
+    {
+      v = other;
+    }
+  }
+
+  // Leaf container, implementing save( archive_t& ) const and load( archive_t& )
+  template <typename T>
+  void merge( T& v )
+  {
+    if ( saving() )
+    {
+      size_t pos = begin_record();
+      v.save( *this );
+      end_record( pos );
+      return;
+    }
+
+    size_t end = record_end();
+    if ( ! m_loaded )
+    {
+      v.load( *this );
+    }
+    m_pos = end;
+  }
+
+  // Single object, implementing serialize( archive_t& )
+  template <typename T>
+  void object( T& obj )
+  {
+    if ( saving() )
+    {
+      size_t pos = begin_record();
+      serialize_object( *this, obj );
+      end_record( pos );
+      return;
+    }
+
+    size_t start = m_pos;
+    size_t end = record_end();
+    bool parent_loaded = m_loaded;
+    m_loaded = m_loaded_records.count( start ) > 0;
+    serialize_object( *this, obj );
+    m_loaded_records.insert( start );
+    m_loaded = parent_loaded;
+    m_pos = end;
+  }
+
+  // Unnamed elements of an object, matched by index. fn( archive_t&, element& ) serializes an
+  // element, surplus elements are skipped when loading.
+  template <typename C, typename F>
+  void sequence( C& container, F fn )
+  {
+    if ( saving() )
+    {
+      write( static_cast<uint64_t>( container.size() ) );
+      for ( auto& elem : container )
+      {
+        size_t pos = begin_record();
+        fn( *this, elem );
+        end_record( pos );
+      }
+      return;
+    }
+
+    auto n = read<uint64_t>();
+    for ( uint64_t i = 0; i < n; ++i )
+    {
+      size_t end = record_end();
+      if ( i < container.size() )
+      {
+        fn( *this, container[ static_cast<size_t>( i ) ] );
+      }
+      m_pos = end;
+    }
+  }
+
+  // Named objects. When loading, find( name ) returns a pointer to the object, or nullptr if it
+  // does not exist.
+  template <typename C, typename F_NAME, typename F_FIND>
+  void objects( C& container, F_NAME name, F_FIND find )
+  {
+    if ( saving() )
+    {
+      write( static_cast<uint64_t>( container.size() ) );
+      for ( auto& obj : container )
+      {
+        write( name( obj ) );
+        size_t pos = begin_record();
+        serialize_object( *this, obj );
+        end_record( pos );
+      }
+      return;
+    }
+
+    auto n = read<uint64_t>();
+    for ( uint64_t i = 0; i < n; ++i )
+    {
+      std::string obj_name;
+      read( obj_name );
+      size_t start = m_pos;
+      size_t end = record_end();
+
+      auto obj = find( obj_name );
+      if ( obj )
+      {
+        bool parent_loaded = m_loaded;
+        m_loaded = m_loaded_records.count( start ) > 0;
+        serialize_object( *this, obj );
+        m_loaded_records.insert( start );
+        m_loaded = parent_loaded;
+      }
+
+      m_pos = end;
+    }
+  }
+};
+
+#endif // SC_ARCHIVE_HPP
@@ -5,6 +5,8 @@
 
 #pragma once
 
+#include <atomic>
+
 // Cache Control ============================================================
 
 namespace cache {
@@ -24,7 +26,8 @@ enum behavior_e
 class cache_control_t
 {
 private:
-  era_t current_era;
+  // Advanced by every simulation, simultaneous simulations (jobs) may share the process
+  std::atomic<era_t> current_era;
   behavior_e player_cache_behavior;
   behavior_e item_cache_behavior;
 
@@ -13,6 +13,9 @@
 #ifdef SC_WINDOWS
 #include <windows.h>
 #include <shellapi.h>
+#else
+#include <dirent.h>
+#include <sys/stat.h>
 #endif
 
 namespace io { // ===========================================================
@@ -268,4 +271,43 @@ std::string read_file_content( FILE* file )
   return buffer;
 }
 
+#ifdef SC_WINDOWS
+bool list_directory( const std::string& path, std::vector<std::string>& files )
+{
+  WIN32_FIND_DATAW data;
+  HANDLE h = FindFirstFileW( widen( path + "\\*" ).c_str(), &data );
+  if ( h == INVALID_HANDLE_VALUE )
+    return false;
+
+  do
+  {
+    if ( ! ( data.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY ) )
+      files.push_back( narrow( data.cFileName ) );
+  } while ( FindNextFileW( h, &data ) );
+
+  FindClose( h );
+  return true;
+}
+
+#else
+
+bool list_directory( const std::string& path, std::vector<std::string>& files )
+{
+  DIR* dir = opendir( path.c_str() );
+  if ( ! dir )
+    return false;
+
+  while ( dirent* entry = readdir( dir ) )
+  {
+    struct stat st;
+    std::string file_path = path + "/" + entry -> d_name;
+    if ( stat( file_path.c_str(), &st ) == 0 && S_ISREG( st.st_mode ) )
+      files.push_back( entry -> d_name );
+  }
+
+  closedir( dir );
+  return true;
+}
+#endif
+
 } // namespace io ===========================================================
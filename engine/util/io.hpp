@@ -89,6 +89,10 @@ inline FILE* fopen( const std::string& filename, const char* mode )
 inline int fclose( cfile& file ) { file.close(); return 0; }
 
 std::string read_file_content( FILE* file );
+
+// Lists the regular files of a directory (names only, unsorted). Returns false if the path is not a
+// readable directory.
+bool list_directory( const std::string& path, std::vector<std::string>& files );
 } // namespace io
 
 #endif // SC_IO_HPP
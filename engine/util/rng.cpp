@@ -39,6 +39,9 @@
 #endif
 
 #include <random>
+#include <sstream>
+#include <cstring>
+#include <stdexcept>
 
 namespace rng {
 
@@ -54,6 +57,23 @@ double convert_to_double_0_1( uint64_t ui64 )
   return u.d - 1.0;
 }
 
+/// Raw state of plain engine data
+template <typename T>
+std::string pod_state( const T& data )
+{
+  return std::string( reinterpret_cast<const char*>( &data ), sizeof( data ) );
+}
+
+template <typename T>
+void restore_pod_state( T& data, const std::string& state )
+{
+  if ( state.size() != sizeof( data ) )
+  {
+    throw std::invalid_argument( "Invalid random number generator state" );
+  }
+  std::memcpy( &data, state.data(), sizeof( data ) );
+}
+
 
 /**
  * @brief STL Mersenne twister MT19937
@@ -81,6 +101,19 @@ struct rng_mt_cxx11_t : public rng_t
   { 
     return dist( engine );
   }
+
+  virtual std::string engine_state() const override
+  {
+    std::ostringstream ss;
+    ss << engine;
+    return ss.str();
+  }
+
+  virtual void restore_engine_state( const std::string& state ) override
+  {
+    std::istringstream ss( state );
+    ss >> engine;
+  }
 };
 
 struct rng_mt_cxx11_64_t : public rng_t
@@ -100,6 +133,19 @@ struct rng_mt_cxx11_64_t : public rng_t
   {
     return convert_to_double_0_1(engine());
   }
+
+  virtual std::string engine_state() const override
+  {
+    std::ostringstream ss;
+    ss << engine;
+    return ss.str();
+  }
+
+  virtual void restore_engine_state( const std::string& state ) override
+  {
+    std::istringstream ss( state );
+    ss >> engine;
+  }
 };
 
 
@@ -133,6 +179,12 @@ struct rng_murmurhash_t : public rng_t
   { 
     return convert_to_double_0_1( next() );
   }
+
+  virtual std::string engine_state() const override
+  { return pod_state( x ); }
+
+  virtual void restore_engine_state( const std::string& state ) override
+  { restore_pod_state( x, state ); }
 };
 
 
@@ -166,6 +218,12 @@ struct rng_xorshift64_t : public rng_t
   { 
     return convert_to_double_0_1( next() );
   }
+
+  virtual std::string engine_state() const override
+  { return pod_state( x ); }
+
+  virtual void restore_engine_state( const std::string& state ) override
+  { restore_pod_state( x, state ); }
 };
 
 
@@ -203,6 +261,12 @@ struct rng_xorshift128_t : public rng_t
   { 
     return convert_to_double_0_1( next() );
   }
+
+  virtual std::string engine_state() const override
+  { return pod_state( s ); }
+
+  virtual void restore_engine_state( const std::string& state ) override
+  { restore_pod_state( s, state ); }
 };
 
 
@@ -241,6 +305,15 @@ struct rng_xorshift1024_t : public rng_t
   { 
     return convert_to_double_0_1( next() );
   }
+
+  virtual std::string engine_state() const override
+  { return pod_state( s ) + pod_state( p ); }
+
+  virtual void restore_engine_state( const std::string& state ) override
+  {
+    restore_pod_state( s, state.substr( 0, sizeof( s ) ) );
+    restore_pod_state( p, state.substr( sizeof( s ) ) );
+  }
 };
 
 
@@ -513,6 +586,12 @@ struct rng_sfmt_t : public rng_t
     return dsfmt_genrand_close_open( &dsfmt_global_data ) - 1.0; 
   }
 
+  virtual std::string engine_state() const override
+  { return pod_state( dsfmt_global_data ); }
+
+  virtual void restore_engine_state( const std::string& state ) override
+  { restore_pod_state( dsfmt_global_data, state ); }
+
   /**
    * Special implementation because dsfmt only allows 32bit seed
    */
@@ -621,6 +700,22 @@ struct rng_tinymt_t : public rng_t
     next_state();
     return temper_conv_open() - 1.0;
   }
+
+  virtual std::string engine_state() const override
+  { return pod_state( status ) + pod_state( mat1 ) + pod_state( mat2 ) + pod_state( tmat ); }
+
+  virtual void restore_engine_state( const std::string& state ) override
+  {
+    if ( state.size() != sizeof( status ) + sizeof( mat1 ) + sizeof( mat2 ) + sizeof( tmat ) )
+    {
+      throw std::invalid_argument( "Invalid random number generator state" );
+    }
+    size_t pos = 0;
+    restore_pod_state( status, state.substr( pos, sizeof( status ) ) ); pos += sizeof( status );
+    restore_pod_state( mat1, state.substr( pos, sizeof( mat1 ) ) ); pos += sizeof( mat1 );
+    restore_pod_state( mat2, state.substr( pos, sizeof( mat2 ) ) ); pos += sizeof( mat2 );
+    restore_pod_state( tmat, state.substr( pos ) );
+  }
 };
 
 } // unnamed
@@ -755,6 +850,26 @@ void rng_t::reset()
   gauss_pair_use = false;
 }
 
+/// Generator state, including the cached value of the gauss distribution
+std::string rng_t::state() const
+{
+  return pod_state( gauss_pair_value ) + pod_state( gauss_pair_use ) + engine_state();
+}
+
+/// Restore generator state saved with state()
+void rng_t::restore( const std::string& state )
+{
+  const size_t header = sizeof( gauss_pair_value ) + sizeof( gauss_pair_use );
+  if ( state.size() < header )
+  {
+    throw std::invalid_argument( "Invalid random number generator state" );
+  }
+
+  restore_pod_state( gauss_pair_value, state.substr( 0, sizeof( gauss_pair_value ) ) );
+  restore_pod_state( gauss_pair_use, state.substr( sizeof( gauss_pair_value ), sizeof( gauss_pair_use ) ) );
+  restore_engine_state( state.substr( header ) );
+}
+
 rng_t::rng_t() :
     gauss_pair_value( 0.0 ), gauss_pair_use( false )
 {
@@ -10,6 +10,7 @@
 
 #include "config.hpp"
 #include <memory>
+#include <string>
 #include "sc_timespan.hpp"
 
 /** \ingroup SC_RNG
@@ -37,6 +38,10 @@ struct rng_t
   virtual uint64_t reseed();
   virtual void reset();
 
+  /// Complete generator state, allows continuing the random sequence exactly (e.g., checkpoints)
+  std::string state() const;
+  void restore( const std::string& state );
+
   bool roll( double chance );
   double range( double min, double max );
   double gauss( double mean, double stddev, bool truncate_low_end = false );
@@ -47,6 +52,8 @@ struct rng_t
   timespan_t exgauss( timespan_t mean, timespan_t stddev, timespan_t nu );
 protected:
   rng_t();
+  virtual std::string engine_state() const = 0;
+  virtual void restore_engine_state( const std::string& state ) = 0;
 private:
   // Allow re-use of unused ( but necessary ) random number of a previous call to gauss()  
   double gauss_pair_value; 
@@ -11,6 +11,7 @@
 #include <sstream>
 #include <vector>
 #include "util/generic.hpp"
+#include "util/archive.hpp"
 
 /* Collection of statistical formulas for sequences
  * Note: Returns 0 for empty sequences
@@ -201,6 +202,93 @@ std::vector<double> create_normalized_histogram( iterator begin, iterator end,
   return normalize_histogram( create_histogram( begin, end, num_buckets ) );
 }
 
+/* Weighted least squares fit of y[ i ] = sum( b[ j ] * x[ i * k + j ] ), x holds one row of k
+ * regressors per observation (include a column of ones for an intercept), w the weight of each
+ * observation. Returns false if the system is singular. Otherwise returns the coefficients, the
+ * inverse of X'WX (k * k, the covariance of the coefficients is residual_variance * inverse), and
+ * the weighted residual variance.
+ */
+inline bool least_squares( const std::vector<double>& x, const std::vector<double>& y,
+                           const std::vector<double>& w, size_t k, std::vector<double>& coefficients,
+                           std::vector<double>& inverse, double& residual_variance )
+{
+  size_t n = y.size();
+  if ( n <= k || x.size() != n * k || w.size() != n )
+    return false;
+
+  // Normal equations X'WX b = X'Wy
+  std::vector<double> a( k * k ), b( k );
+  for ( size_t i = 0; i < n; ++i )
+  {
+    const double* row = &x[ i * k ];
+    for ( size_t r = 0; r < k; ++r )
+    {
+      b[ r ] += w[ i ] * row[ r ] * y[ i ];
+      for ( size_t c = 0; c < k; ++c )
+        a[ r * k + c ] += w[ i ] * row[ r ] * row[ c ];
+    }
+  }
+
+  // Gauss-Jordan elimination with partial pivoting, inverting X'WX alongside
+  inverse.assign( k * k, 0.0 );
+  for ( size_t r = 0; r < k; ++r )
+    inverse[ r * k + r ] = 1;
+
+  for ( size_t c = 0; c < k; ++c )
+  {
+    size_t pivot = c;
+    for ( size_t r = c + 1; r < k; ++r )
+      if ( std::fabs( a[ r * k + c ] ) > std::fabs( a[ pivot * k + c ] ) )
+        pivot = r;
+
+    if ( std::fabs( a[ pivot * k + c ] ) < 1e-12 )
+      return false;
+
+    for ( size_t j = 0; j < k; ++j )
+    {
+      std::swap( a[ c * k + j ], a[ pivot * k + j ] );
+      std::swap( inverse[ c * k + j ], inverse[ pivot * k + j ] );
+    }
+    std::swap( b[ c ], b[ pivot ] );
+
+    double d = a[ c * k + c ];
+    for ( size_t j = 0; j < k; ++j )
+    {
+      a[ c * k + j ] /= d;
+      inverse[ c * k + j ] /= d;
+    }
+    b[ c ] /= d;
+
+    for ( size_t r = 0; r < k; ++r )
+    {
+      if ( r == c || a[ r * k + c ] == 0 )
+        continue;
+
+      double f = a[ r * k + c ];
+      for ( size_t j = 0; j < k; ++j )
+      {
+        a[ r * k + j ] -= f * a[ c * k + j ];
+        inverse[ r * k + j ] -= f * inverse[ c * k + j ];
+      }
+      b[ r ] -= f * b[ c ];
+    }
+  }
+
+  double rss = 0;
+  for ( size_t i = 0; i < n; ++i )
+  {
+    double fit = 0;
+    for ( size_t j = 0; j < k; ++j )
+      fit += b[ j ] * x[ i * k + j ];
+    rss += w[ i ] * ( y[ i ] - fit ) * ( y[ i ] - fit );
+  }
+
+  coefficients = b;
+  residual_variance = rss / ( n - k );
+
+  return true;
+}
+
 }  // end sd namespace
 
 /* Simplest Samplest Data container. Only tracks sum and count
@@ -255,11 +343,38 @@ public:
     _sum += other._sum;
   }
 
+  // Replace sum and count with values accumulated elsewhere, continuing from sum() and count()
+  void assign( value_t sum, size_t count )
+  {
+    _sum   = sum;
+    _count = count;
+  }
+
   void reset()
   {
     _count = 0u;
     _sum   = 0.0;
   }
+
+  void save( archive_t& ar ) const
+  {
+    ar.write( _count );
+    ar.write( _sum );
+  }
+
+  void load( archive_t& ar )
+  {
+    simple_sample_data_t other;
+    other.read_fields( ar );
+    merge( other );
+  }
+
+protected:
+  void read_fields( archive_t& ar )
+  {
+    _count = ar.read<size_t>();
+    _sum   = ar.read<value_t>();
+  }
 };
 
 /* Second simplest Samplest Data container. Tracks sum, count as well as min/max
@@ -300,6 +415,19 @@ public:
     }
   }
 
+  // Extend the range with the minimum and maximum of values accumulated elsewhere
+  void add_range( value_t min, value_t max )
+  {
+    if ( min < _min )
+    {
+      set_min( min );
+    }
+    if ( max > _max )
+    {
+      set_max( max );
+    }
+  }
+
   bool found_min_max() const
   {
     return _found;
@@ -329,6 +457,30 @@ public:
       }
     }
   }
+
+  void save( archive_t& ar ) const
+  {
+    base_t::save( ar );
+    ar.write( _found );
+    ar.write( _min );
+    ar.write( _max );
+  }
+
+  void load( archive_t& ar )
+  {
+    simple_sample_data_with_min_max_t other;
+    other.read_fields( ar );
+    merge( other );
+  }
+
+protected:
+  void read_fields( archive_t& ar )
+  {
+    base_t::read_fields( ar );
+    _found = ar.read<bool>();
+    _min   = ar.read<value_t>();
+    _max   = ar.read<value_t>();
+  }
 };
 
 /* Extensive sample_data container with two runtime dependent modes:
@@ -569,6 +721,31 @@ public:
       _data.insert( _data.end(), other._data.begin(), other._data.end() );
   }
 
+  void save( archive_t& ar ) const
+  {
+    base_t::save( ar );
+    ar.write( _data );
+  }
+
+  // Loaded samples precede the samples collected so far, which keeps the original sample order
+  // when resuming a simulation
+  void load( archive_t& ar )
+  {
+    extended_sample_data_t other( name_str, simple );
+    other.read_fields( ar );
+    ar.read( other._data );
+
+    if ( simple )
+    {
+      base_t::merge( other );
+    }
+    else
+    {
+      _data.insert( _data.begin(), other._data.begin(), other._data.end() );
+      is_sorted = false;
+    }
+  }
+
   std::ostream& data_str( std::ostream& s ) const
   {
     s << "Sample_Data \"" << name_str << "\": count: " << count();
@@ -0,0 +1,186 @@
+// ==========================================================================
+// Dedmonwakeen's Raid DPS/TPS Simulator.
+// Send questions to natehieter@gmail.com
+// ==========================================================================
+
+#include "symbol.hpp"
+
+#include <array>
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <vector>
+
+namespace
+{
+// Names are stored in fixed size chunks that never move, so that they can be read without locking
+// while new names are interned
+const uint32_t CHUNK_BITS = 10;
+const uint32_t CHUNK_SIZE = 1u << CHUNK_BITS;
+const uint32_t MAX_CHUNKS = 4096;
+
+// Open addressing hash index of the interned names. Each slot holds the hash of the name in the
+// upper, and the symbol in the lower 32 bits, an empty slot is zero. A full index is replaced by a
+// larger copy, and never freed, so readers can keep using the index they loaded.
+struct index_t
+{
+  std::unique_ptr<std::atomic<uint64_t>[]> slots;
+  size_t mask;
+  size_t used;
+
+  explicit index_t( size_t capacity ) :
+    slots( new std::atomic<uint64_t>[ capacity ] ), mask( capacity - 1 ), used( 0 )
+  {
+    for ( size_t i = 0; i < capacity; ++i )
+    {
+      slots[ i ].store( 0, std::memory_order_relaxed );
+    }
+  }
+
+  // Writer only, called with the table locked
+  void insert( uint32_t hash, uint32_t id )
+  {
+    size_t i = hash & mask;
+    while ( slots[ i ].load( std::memory_order_relaxed ) != 0 )
+    {
+      i = ( i + 1 ) & mask;
+    }
+
+    slots[ i ].store( ( static_cast<uint64_t>( hash ) << 32 ) | id, std::memory_order_release );
+    ++used;
+  }
+};
+
+// Process-wide symbol table. Lookups (symbol::find, symbol::name, and symbol::intern of a known
+// name) are lock-free, only interning a new name takes the lock.
+struct symbol_table_t
+{
+  std::mutex mutex;
+  std::array<std::atomic<std::string*>, MAX_CHUNKS> chunks;
+  std::atomic<uint32_t> size;
+  std::atomic<index_t*> index;
+
+  // Owned storage, only accessed with the table locked
+  std::vector<std::unique_ptr<std::string[]>> chunk_storage;
+  std::vector<std::unique_ptr<index_t>> indices;
+
+  symbol_table_t()
+  {
+    for ( auto& chunk : chunks )
+    {
+      chunk.store( nullptr, std::memory_order_relaxed );
+    }
+
+    // Symbol 0 is the invalid symbol
+    chunk_storage.emplace_back( new std::string[ CHUNK_SIZE ] );
+    chunks[ 0 ].store( chunk_storage.back().get(), std::memory_order_relaxed );
+    size.store( 1, std::memory_order_relaxed );
+
+    indices.emplace_back( new index_t( 1024 ) );
+    index.store( indices.back().get(), std::memory_order_relaxed );
+  }
+
+  const std::string& name( uint32_t id ) const
+  { return chunks[ id >> CHUNK_BITS ].load( std::memory_order_acquire )[ id & ( CHUNK_SIZE - 1 ) ]; }
+
+  uint32_t find( const std::string& name, uint32_t hash ) const
+  {
+    const index_t* idx = index.load( std::memory_order_acquire );
+    for ( size_t i = hash & idx -> mask; ; i = ( i + 1 ) & idx -> mask )
+    {
+      uint64_t slot = idx -> slots[ i ].load( std::memory_order_acquire );
+      if ( slot == 0 )
+      {
+        return 0;
+      }
+
+      uint32_t id = static_cast<uint32_t>( slot );
+      if ( static_cast<uint32_t>( slot >> 32 ) == hash && this -> name( id ) == name )
+      {
+        return id;
+      }
+    }
+  }
+};
+
+symbol_table_t& table()
+{
+  static symbol_table_t t;
+  return t;
+}
+
+uint32_t hash_name( const std::string& name )
+{
+  uint64_t h = std::hash<std::string>()( name );
+  return static_cast<uint32_t>( h ^ ( h >> 32 ) );
+}
+} // unnamed namespace
+
+namespace symbol
+{
+symbol_t intern( const std::string& name )
+{
+  symbol_table_t& t = table();
+  uint32_t hash = hash_name( name );
+
+  if ( uint32_t id = t.find( name, hash ) )
+  {
+    return symbol_t( id );
+  }
+
+  std::lock_guard<std::mutex> lock( t.mutex );
+
+  // Interned by another thread in the meantime
+  if ( uint32_t id = t.find( name, hash ) )
+  {
+    return symbol_t( id );
+  }
+
+  uint32_t id = t.size.load( std::memory_order_relaxed );
+  if ( id >= CHUNK_SIZE * MAX_CHUNKS )
+  {
+    throw std::length_error( "Too many interned names" );
+  }
+
+  std::string* chunk = t.chunks[ id >> CHUNK_BITS ].load( std::memory_order_relaxed );
+  if ( ! chunk )
+  {
+    t.chunk_storage.emplace_back( new std::string[ CHUNK_SIZE ] );
+    chunk = t.chunk_storage.back().get();
+    t.chunks[ id >> CHUNK_BITS ].store( chunk, std::memory_order_release );
+  }
+
+  chunk[ id & ( CHUNK_SIZE - 1 ) ] = name;
+  t.size.store( id + 1, std::memory_order_release );
+
+  // Keep the index at most half full, so that probing always ends at an empty slot
+  index_t* idx = t.index.load( std::memory_order_relaxed );
+  if ( ( idx -> used + 1 ) * 2 > idx -> mask + 1 )
+  {
+    t.indices.emplace_back( new index_t( ( idx -> mask + 1 ) * 2 ) );
+    idx = t.indices.back().get();
+    for ( uint32_t i = 1; i < id; ++i )
+    {
+      idx -> insert( hash_name( t.name( i ) ), i );
+    }
+    t.index.store( idx, std::memory_order_release );
+  }
+
+  idx -> insert( hash, id );
+
+  return symbol_t( id );
+}
+
+symbol_t find( const std::string& name )
+{
+  return symbol_t( table().find( name, hash_name( name ) ) );
+}
+
+const std::string& name( symbol_t symbol )
+{
+  const symbol_table_t& t = table();
+
+  return symbol.id < t.size.load( std::memory_order_acquire ) ? t.name( symbol.id ) : t.name( 0 );
+}
+} // Namespace symbol ends
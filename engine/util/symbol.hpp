@@ -0,0 +1,99 @@
+// ==========================================================================
+// Dedmonwakeen's Raid DPS/TPS Simulator.
+// Send questions to natehieter@gmail.com
+// ==========================================================================
+
+#ifndef SC_SYMBOL_HPP
+#define SC_SYMBOL_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <unordered_map>
+
+/* Interned names
+ *
+ * Names of buffs, cooldowns, dots, gains and procs are interned into a process-wide table, turning
+ * them into integer symbols that can be compared and hashed in constant time. Symbols are never
+ * released, and are shared by all simulations (and simulator threads) of the process. Lookups are
+ * lock-free, only interning a name that is not yet known takes a lock.
+ */
+struct symbol_t
+{
+  uint32_t id;
+
+  symbol_t() : id( 0 )
+  { }
+
+  explicit symbol_t( uint32_t i ) : id( i )
+  { }
+
+  // The default symbol does not refer to any name
+  bool valid() const
+  { return id != 0; }
+
+  bool operator==( const symbol_t& other ) const
+  { return id == other.id; }
+
+  bool operator!=( const symbol_t& other ) const
+  { return id != other.id; }
+};
+
+namespace symbol
+{
+// Symbol of the name, the name is interned if necessary
+symbol_t intern( const std::string& name );
+
+// Symbol of an already interned name, or an invalid symbol if the name was never interned
+symbol_t find( const std::string& name );
+
+const std::string& name( symbol_t symbol );
+} // Namespace symbol ends
+
+/* Symbol-indexed lookup table of named objects
+ *
+ * Objects are optionally keyed by an owner in addition to their name (e.g., the source actor of a
+ * buff or dot). The first object inserted under a key is kept, which matches a linear search over
+ * the vector the objects are appended to.
+ */
+template <typename T>
+class symbol_index_t
+{
+  struct key_t
+  {
+    symbol_t symbol;
+    const void* owner;
+
+    bool operator==( const key_t& other ) const
+    { return symbol == other.symbol && owner == other.owner; }
+  };
+
+  struct key_hash_t
+  {
+    size_t operator()( const key_t& key ) const
+    { return std::hash<const void*>()( key.owner ) * 31 + key.symbol.id; }
+  };
+
+  std::unordered_map<key_t, T*, key_hash_t> m_index;
+
+public:
+  void insert( symbol_t symbol, T* obj, const void* owner = nullptr )
+  { m_index.insert( std::make_pair( key_t { symbol, owner }, obj ) ); }
+
+  T* find( symbol_t symbol, const void* owner = nullptr ) const
+  {
+    if ( ! symbol.valid() )
+    {
+      return nullptr;
+    }
+
+    auto it = m_index.find( key_t { symbol, owner } );
+    return it != m_index.end() ? it -> second : nullptr;
+  }
+
+  void clear()
+  { m_index.clear(); }
+};
+
+#endif // SC_SYMBOL_HPP
@@ -94,20 +94,18 @@ public:
   void resize( size_t length )
   { _data.resize( length ); }
 
+  // Preallocate storage for 'length' bins, without changing the length of the timeline
+  void reserve( size_t length )
+  { _data.reserve( length ); }
+
   // Add 'value' at the specific index
   void add( size_t index, double value )
   {
-    if ( index >= _data.capacity() ) // we need to reallocate
-    {
-      // Reserve data less aggressively than doubling the size every time
-      _data.reserve( std::max( size_t( 10 ), static_cast<size_t>( index * 1.25 ) ) );
-      _data.resize( index + 1 );
-    }
-    else if ( index >= _data.size() ) // we still have enough capacity left, but need to resize up to index
+    if ( index >= _data.size() )
     {
-      _data.resize( index + 1 );
+      grow( index );
     }
-    _data.at( index ) += value;
+    _data[ index ] += value;
   }
 
   // Adjust timeline by dividing through divisor timeline
@@ -140,13 +138,27 @@ public:
   // Merge with other timeline
   void merge( const timeline_t& other )
   {
-    // merge shared range
-    for ( size_t j = 0, num_buckets = std::min( _data.size(), other.data().size() ); j < num_buckets; ++j )
-      _data[ j ] += other.data()[ j ];
+    size_t num_buckets = std::min( _data.size(), other.data().size() );
 
     // if other is larger, insert tail
     if ( _data.size() < other.data().size() )
       _data.insert( _data.end(), other.data().begin() + _data.size(), other.data().end() );
+
+    // merge shared range; plain loop over raw pointers so the compiler can vectorize it
+    double* data = _data.data();
+    const double* other_data = other.data().data();
+    for ( size_t j = 0; j < num_buckets; ++j )
+      data[ j ] += other_data[ j ];
+  }
+
+  void save( archive_t& ar ) const
+  { ar.write( _data ); }
+
+  void load( archive_t& ar )
+  {
+    timeline_t other;
+    ar.read( other._data );
+    merge( other );
   }
 
   void build_sliding_average_timeline( timeline_t& out, unsigned window ) const
@@ -177,6 +189,19 @@ public:
     s << "\n";
     return s;
   }
+private:
+  // Slow path of add(), only taken when the timeline has to be extended
+  void grow( size_t index )
+  {
+    if ( index >= _data.capacity() ) // we need to reallocate
+    {
+      // Reserve data less aggressively than doubling the size every time
+      _data.reserve( std::max( size_t( 10 ), static_cast<size_t>( index * 1.25 ) ) );
+    }
+    _data.resize( index + 1 );
+  }
+
+public:
   /*
     // Functions which could be implemented:
     data_type variance() const;
@@ -361,6 +386,7 @@ struct sc_timeline_t : public timeline_t
 {
   typedef timeline_t base_t;
   using timeline_t::add;
+  using timeline_t::reserve;
   double bin_size;
 
   sc_timeline_t() : timeline_t(), bin_size( 1.0 ) {}
@@ -375,6 +401,10 @@ struct sc_timeline_t : public timeline_t
     return bin_size;
   }
 
+  // Preallocate bins for timelines up to 'max_time' long
+  void reserve( timespan_t max_time )
+  { base_t::reserve( static_cast<size_t>( max_time.total_millis() / 1000 / bin_size ) + 1 ); }
+
   // Add 'value' at the corresponding time
   void add( timespan_t current_time, double value )
   { base_t::add( static_cast<size_t>( current_time.total_millis() / 1000 / bin_size ), value ); }
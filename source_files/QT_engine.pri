@@ -4,6 +4,7 @@
 
  HEADERS += engine/util/xml.hpp
  HEADERS += engine/util/timeline.hpp
+ HEADERS += engine/util/symbol.hpp
  HEADERS += engine/util/str.hpp
  HEADERS += engine/util/stopwatch.hpp
  HEADERS += engine/util/sc_resourcepaths.hpp
@@ -13,10 +14,15 @@
  HEADERS += engine/util/generic.hpp
  HEADERS += engine/util/concurrency.hpp
  HEADERS += engine/util/cache.hpp
+ HEADERS += engine/util/archive.hpp
  HEADERS += engine/sim/x7_pantheon.hpp
  HEADERS += engine/sim/sc_profileset.hpp
  HEADERS += engine/sim/sc_option.hpp
+ HEADERS += engine/sim/sc_job.hpp
  HEADERS += engine/sim/sc_expressions.hpp
+ HEADERS += engine/sim/sc_checkpoint.hpp
+ HEADERS += engine/sim/sc_health_calibration.hpp
+ HEADERS += engine/sim/sc_result_file.hpp
  HEADERS += engine/report/sc_report.hpp
  HEADERS += engine/player/artifact_data.hpp
  HEADERS += engine/dbc/specialization.hpp
@@ -34,6 +40,7 @@
  HEADERS += engine/util/utf8/checked.h
  HEADERS += engine/util/utf8.h
  SOURCES += engine/util/xml.cpp
+ SOURCES += engine/util/symbol.cpp
  SOURCES += engine/util/str.cpp
  SOURCES += engine/util/stopwatch.cpp
  SOURCES += engine/util/rng.cpp
@@ -41,6 +48,7 @@
  SOURCES += engine/util/concurrency.cpp
  SOURCES += engine/sim/x7_pantheon.cpp
  SOURCES += engine/sim/sc_sim.cpp
+ SOURCES += engine/sim/sc_server.cpp
  SOURCES += engine/sim/sc_scaling.cpp
  SOURCES += engine/sim/sc_reforge_plot.cpp
  SOURCES += engine/sim/sc_raid_event.cpp
@@ -48,11 +56,16 @@
  SOURCES += engine/sim/sc_profileset.cpp
  SOURCES += engine/sim/sc_plot.cpp
  SOURCES += engine/sim/sc_option.cpp
+ SOURCES += engine/sim/sc_job.cpp
  SOURCES += engine/sim/sc_gear_stats.cpp
  SOURCES += engine/sim/sc_expressions.cpp
  SOURCES += engine/sim/sc_event.cpp
  SOURCES += engine/sim/sc_core_sim.cpp
  SOURCES += engine/sim/sc_cooldown.cpp
+ SOURCES += engine/sim/sc_checkpoint.cpp
+ SOURCES += engine/sim/sc_health_calibration.cpp
+ SOURCES += engine/sim/sc_result_file.cpp
+ SOURCES += engine/sim/sc_batch.cpp
  SOURCES += engine/report/sc_report_xml.cpp
  SOURCES += engine/report/sc_report_text.cpp
  SOURCES += engine/report/sc_report_json.cpp
@@ -0,0 +1,52 @@
+load test_helper
+
+# Checkpoint after every iteration, then resume from the checkpoint of the finished simulation. The
+# resumed simulation has no work left, and reports the iterations of the checkpointed one.
+@test "Checkpoint and resume" {
+  DIR="$(mktemp -d "${BATS_TMPDIR}/simc_checkpoint.XXXXXX")"
+
+  sim threads=2 checkpoint="${DIR}/sim.ckpt" checkpoint_interval=0
+  [ "${status}" -eq 0 ]
+  [ -s "${DIR}/sim.ckpt" ]
+  ITERATIONS="$(echo "${output}" | grep -E "^ +Iterations +=")"
+  [ -n "${ITERATIONS}" ]
+
+  sim threads=2 checkpoint="${DIR}/sim.ckpt" checkpoint_interval=0 checkpoint_resume=1
+  [ "${status}" -eq 0 ]
+  echo "${output}" | grep -q "Resuming simulation from checkpoint"
+  [ "$(echo "${output}" | grep -E "^ +Iterations +=")" = "${ITERATIONS}" ]
+
+  rm -rf "${DIR}"
+}
+
+# Kill a simulation after its first checkpoint, and resume it from the checkpoint. The resumed
+# simulation reports the same results as an uninterrupted deterministic simulation.
+@test "Resume an interrupted simulation" {
+  DIR="$(mktemp -d "${BATS_TMPDIR}/simc_checkpoint.XXXXXX")"
+  OPTIONS="threads=1 deterministic=1 iterations=10000 checkpoint=${DIR}/sim.ckpt checkpoint_interval=0"
+
+  sim threads=1 deterministic=1 iterations=10000
+  [ "${status}" -eq 0 ]
+  DPS="$(echo "${output}" | grep -E "^ +DPS: ")"
+  [ -n "${DPS}" ]
+
+  cd "${SIMC_PROFILES_PATH}"
+  "${SIMC_CLI_PATH}" "${SIMC_PROFILE}" iterations=${SIMC_ITERATIONS} ${OPTIONS} > /dev/null 2>&1 &
+  PID=$!
+  while [ ! -s "${DIR}/sim.ckpt" ] && kill -0 ${PID} 2> /dev/null; do
+    sleep 0.1
+  done
+  kill -9 ${PID} 2> /dev/null || true
+  wait ${PID} || true
+  cd -
+  [ -s "${DIR}/sim.ckpt" ]
+
+  sim ${OPTIONS} checkpoint_resume=1
+  [ "${status}" -eq 0 ]
+  RESUMED="$(echo "${output}" | sed -nE "s/^Resuming simulation from checkpoint .* after ([0-9]+) iterations.*/\1/p")"
+  [ -n "${RESUMED}" ]
+  [ "${RESUMED}" -lt 10000 ]
+  [ "$(echo "${output}" | grep -E "^ +DPS: ")" = "${DPS}" ]
+
+  rm -rf "${DIR}"
+}
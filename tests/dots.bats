@@ -0,0 +1,16 @@
+load test_helper
+
+# Dot ticks batched per tick time execute in the order of unbatched ticks, so a deterministic
+# simulation reports the same results with and without batching, also when multi-dotting
+@test "Batched dot ticks report the same results" {
+  for targets in 1 5; do
+    sim threads=2 deterministic=1 desired_targets=${targets}
+    [ "${status}" -eq 0 ]
+    REPORT="$(echo "${output}" | grep -E "(^ +DPS: | Count=)")"
+    [ -n "${REPORT}" ]
+
+    sim threads=2 deterministic=1 desired_targets=${targets} batch_dot_ticks=1
+    [ "${status}" -eq 0 ]
+    [ "$(echo "${output}" | grep -E "(^ +DPS: | Count=)")" = "${REPORT}" ]
+  done
+}
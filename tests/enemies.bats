@@ -25,3 +25,24 @@ load test_helper
   [ "${status}" -eq 0 ]
 }
 
+
+# Save a calibrated enemy health, then load it instead of calibrating. A simulation that only saves
+# calibrates again, even if the file exists.
+@test "Save and load enemy health calibration" {
+  DIR="$(mktemp -d "${BATS_TMPDIR}/simc_health.XXXXXX")"
+
+  sim threads=2 enemy_health_calibration=3 enemy_health_calibration_save="${DIR}/health"
+  [ "${status}" -eq 0 ]
+  [ -s "${DIR}/health" ]
+  echo "${output}" | grep -q "Calibrated enemy health"
+
+  sim threads=2 enemy_health_calibration=3 enemy_health_calibration_save="${DIR}/health"
+  [ "${status}" -eq 0 ]
+  echo "${output}" | grep -q "Calibrated enemy health"
+
+  sim threads=2 enemy_health_calibration=3 enemy_health_calibration_load="${DIR}/health"
+  [ "${status}" -eq 0 ]
+  echo "${output}" | grep -q "Loaded enemy health calibration"
+
+  rm -rf "${DIR}"
+}
@@ -0,0 +1,36 @@
+load test_helper
+
+# Submit a long job over the stdio server protocol and cancel it, then cancel a job id the session
+# does not know
+@test "Server run and cancel over stdio" {
+  DIR="$(mktemp -d "${BATS_TMPDIR}/simc_server.XXXXXX")"
+  OPTS=$'iterations=100000\n'
+  printf 'run a %d\n%scancel a\ncancel b\nquit\n' "${#OPTS}" "${OPTS}" > "${DIR}/requests"
+
+  sim server=stdio < "${DIR}/requests"
+  [ "${status}" -eq 0 ]
+  echo "${output}" | grep -qE "canceled a [0-9]+"
+  echo "${output}" | grep -qE "error b [0-9]+"
+  echo "${output}" | grep -q "No such job"
+
+  rm -rf "${DIR}"
+}
+
+# Batch inputs with the same file name stem get unique report names: a.simc is given twice, and the
+# first rename of the second a.simc collides with a_2.simc
+@test "Batch inputs with duplicate stems" {
+  DIR="$(mktemp -d "${BATS_TMPDIR}/simc_batch.XXXXXX")"
+  mkdir "${DIR}/input" "${DIR}/output"
+  echo "desired_targets=1" > "${DIR}/input/a.simc"
+  echo "desired_targets=2" > "${DIR}/input/a_2.simc"
+
+  sim batch="${DIR}/input" batch="${DIR}/input/a.simc" batch_output="${DIR}/output"
+  [ "${status}" -eq 0 ]
+  for name in a a_2 a_3; do
+    [ -s "${DIR}/output/${name}.json" ]
+    [ -s "${DIR}/output/${name}.txt" ]
+  done
+  [ "$(ls "${DIR}/output" | wc -l)" -eq 6 ]
+
+  rm -rf "${DIR}"
+}
@@ -0,0 +1,36 @@
+load test_helper
+
+# Save the results of a simulation, and report the saved results without simulating. The report of
+# the loaded results shows the same actor results as the simulation.
+@test "Save and load results" {
+  DIR="$(mktemp -d "${BATS_TMPDIR}/simc_results.XXXXXX")"
+
+  sim threads=2 save_results="${DIR}/sim.results"
+  [ "${status}" -eq 0 ]
+  [ -s "${DIR}/sim.results" ]
+  DPS="$(echo "${output}" | grep -E "^ +DPS: ")"
+  [ -n "${DPS}" ]
+
+  sim threads=2 load_results="${DIR}/sim.results" json2="${DIR}/loaded.json"
+  [ "${status}" -eq 0 ]
+  echo "${output}" | grep -q "Loading results from"
+  [ -s "${DIR}/loaded.json" ]
+  [ "$(echo "${output}" | grep -E "^ +DPS: ")" = "${DPS}" ]
+
+  rm -rf "${DIR}"
+}
+
+# Results saved by a simulation of different options are not loaded
+@test "Reject results of different options" {
+  DIR="$(mktemp -d "${BATS_TMPDIR}/simc_results.XXXXXX")"
+
+  sim threads=2 save_results="${DIR}/sim.results"
+  [ "${status}" -eq 0 ]
+  [ -s "${DIR}/sim.results" ]
+
+  sim threads=2 desired_targets=2 load_results="${DIR}/sim.results"
+  [ "${status}" -ne 0 ]
+  echo "${output}" | grep -q "different options or actors"
+
+  rm -rf "${DIR}"
+}
@@ -0,0 +1,14 @@
+load test_helper
+
+# Action results collected with the structure-of-arrays accumulator are reported exactly like
+# results added to the sample data directly
+@test "Stats accumulator reports the same results" {
+  sim threads=2 deterministic=1
+  [ "${status}" -eq 0 ]
+  REPORT="$(echo "${output}" | grep -E "(^ +DPS: | Count=)")"
+  [ -n "${REPORT}" ]
+
+  sim threads=2 deterministic=1 stats_accumulator=1
+  [ "${status}" -eq 0 ]
+  [ "$(echo "${output}" | grep -E "(^ +DPS: | Count=)")" = "${REPORT}" ]
+}
@@ -0,0 +1,27 @@
+load test_helper
+
+# Deterministic simulations merge the results of their threads in thread index order, and report
+# the same results on every run
+@test "Deterministic multithreaded merge" {
+  sim threads=4 deterministic=1
+  [ "${status}" -eq 0 ]
+  DPS="$(echo "${output}" | grep -E "^ +DPS: ")"
+  [ -n "${DPS}" ]
+
+  sim threads=4 deterministic=1
+  [ "${status}" -eq 0 ]
+  [ "$(echo "${output}" | grep -E "^ +DPS: ")" = "${DPS}" ]
+}
+
+# Actors with items initialized in parallel report the same results as actors initialized
+# sequentially
+@test "Parallel actor initialization" {
+  sim threads=4 deterministic=1 copy=copy_1 copy=copy_2 copy=copy_3
+  [ "${status}" -eq 0 ]
+  REPORT="$(echo "${output}" | grep -E "(^ +DPS: | Count=)")"
+  [ -n "${REPORT}" ]
+
+  sim threads=4 deterministic=1 copy=copy_1 copy=copy_2 copy=copy_3 parallel_actor_init=1
+  [ "${status}" -eq 0 ]
+  [ "$(echo "${output}" | grep -E "(^ +DPS: | Count=)")" = "${REPORT}" ]
+}